@@ -82,15 +82,20 @@ namespace
     bool plot_files_output;
     int  checkpoint_nfiles;
     int  regrid_on_restart;
+    int  redecompose_on_restart;
     int  use_efficient_regrid;
     int  plotfile_on_restart;
     int  checkpoint_on_restart;
     bool checkpoint_files_output;
     int  compute_new_dt_on_regrid;
+    int  loadbalance_with_cost;
+    int  incremental_regrid;
+    Real loadbalance_efficiency;
     bool precreateDirectories;
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
     VisMF::Header::Version checkpoint_headerversion(VisMF::Header::Version_v1);
+    Real plot_compression_tolerance;
 
 }
 
@@ -109,15 +114,20 @@ Amr::Initialize ()
     plot_files_output        = true;
     checkpoint_nfiles        = 64;
     regrid_on_restart        = 0;
+    redecompose_on_restart   = 0;
     use_efficient_regrid     = 0;
     plotfile_on_restart      = 0;
     checkpoint_on_restart    = 0;
     checkpoint_files_output  = true;
     compute_new_dt_on_regrid = 0;
+    loadbalance_with_cost    = 0;
+    incremental_regrid       = 0;
+    loadbalance_efficiency   = 0.9;
     precreateDirectories     = true;
     prereadFAHeaders         = true;
     plot_headerversion       = VisMF::Header::Version_v1;
     checkpoint_headerversion = VisMF::Header::Version_v1;
+    plot_compression_tolerance = 0;
 
     amrex::ExecOnFinalize(Amr::Finalize);
 
@@ -155,6 +165,18 @@ Amr::RegridOnRestart () const
     return regrid_on_restart;
 }
 
+bool
+Amr::RedecomposeOnRestart () const
+{
+    return redecompose_on_restart;
+}
+
+bool
+Amr::loadBalanceWithCost ()
+{
+    return loadbalance_with_cost;
+}
+
 void
 Amr::setDtMin (const Array<Real>& dt_min_in)
 {
@@ -240,12 +262,18 @@ Amr::InitAmr ()
     // Check for command line flags.
     //
     pp.query("regrid_on_restart",regrid_on_restart);
+    pp.query("redecompose_on_restart",redecompose_on_restart);
     pp.query("use_efficient_regrid",use_efficient_regrid);
     pp.query("plotfile_on_restart",plotfile_on_restart);
     pp.query("checkpoint_on_restart",checkpoint_on_restart);
 
     pp.query("compute_new_dt_on_regrid",compute_new_dt_on_regrid);
 
+    pp.query("loadbalance_with_cost",loadbalance_with_cost);
+    pp.query("loadbalance_efficiency",loadbalance_efficiency);
+
+    pp.query("incremental_regrid",incremental_regrid);
+
     pp.query("mffile_nstreams", mffile_nstreams);
     pp.query("probinit_natonce", probinit_natonce);
 
@@ -705,9 +733,13 @@ Amr::writePlotFile ()
     BL_PROFILE_REGION_START("Amr::writePlotFile()");
     BL_PROFILE("Amr::writePlotFile()");
 
+    VisMF::FinishAsyncWrites();  // ---- the previous output must be out first
+
     VisMF::SetNOutFiles(plot_nfiles);
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(plot_headerversion);
+    Real currentTolerance(VisMF::GetCompressionTolerance());
+    VisMF::SetCompressionTolerance(plot_compression_tolerance);
 
     if (first_plotfile) {
         first_plotfile = false;
@@ -794,17 +826,21 @@ Amr::writePlotFile ()
     }
     ParallelDescriptor::Barrier("Amr::writePlotFile::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(pltfileTemp.c_str(), pltfile.c_str());
-    }
+    //
+    // With asynchronous writes the data may still be on their way, so
+    // the rename waits for them (see VisMF::RenameWhenWritten).
+    //
+    VisMF::RenameWhenWritten(pltfileTemp, pltfile);
     ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     //
-    // the plotfile file now has the regular name
+    // the plotfile file now has the regular name, or will have it after
+    // the next VisMF::FinishAsyncWrites()
     //
 
   }  // end while
 
   VisMF::SetHeaderVersion(currentVersion);
+  VisMF::SetCompressionTolerance(currentTolerance);
   
   BL_PROFILE_REGION_STOP("Amr::writePlotFile()");
 }
@@ -819,9 +855,13 @@ Amr::writeSmallPlotFile ()
     BL_PROFILE_REGION_START("Amr::writeSmallPlotFile()");
     BL_PROFILE("Amr::writeSmallPlotFile()");
 
+    VisMF::FinishAsyncWrites();  // ---- the previous output must be out first
+
     VisMF::SetNOutFiles(plot_nfiles);
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(plot_headerversion);
+    Real currentTolerance(VisMF::GetCompressionTolerance());
+    VisMF::SetCompressionTolerance(plot_compression_tolerance);
 
     if (first_smallplotfile) {
         first_smallplotfile = false;
@@ -919,17 +959,17 @@ Amr::writeSmallPlotFile ()
     }
     ParallelDescriptor::Barrier("Amr::writeSmallPlotFile::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(pltfileTemp.c_str(), pltfile.c_str());
-    }
+    VisMF::RenameWhenWritten(pltfileTemp, pltfile);
     ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     //
-    // the plotfile file now has the regular name
+    // the plotfile file now has the regular name, or will have it after
+    // the next VisMF::FinishAsyncWrites()
     //
 
   }  // end while
 
   VisMF::SetHeaderVersion(currentVersion);
+  VisMF::SetCompressionTolerance(currentTolerance);
   
   BL_PROFILE_REGION_STOP("Amr::writeSmallPlotFile()");
 }
@@ -1562,6 +1602,8 @@ Amr::checkPoint ()
     BL_PROFILE_REGION_START("Amr::checkPoint()");
     BL_PROFILE("Amr::checkPoint()");
 
+    VisMF::FinishAsyncWrites();  // ---- the previous output must be out first
+
     VisMF::SetNOutFiles(checkpoint_nfiles);
     //
     // In checkpoint files always write out FABs in NATIVE format.
@@ -1572,6 +1614,11 @@ Amr::checkPoint ()
 
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(checkpoint_headerversion);
+    //
+    // Checkpoints are never compressed lossy.
+    //
+    Real currentTolerance(VisMF::GetCompressionTolerance());
+    VisMF::SetCompressionTolerance(0.0);
 
     Real dCheckPointTime0 = ParallelDescriptor::second();
 
@@ -1705,9 +1752,7 @@ Amr::checkPoint ()
     }
     ParallelDescriptor::Barrier("Amr::checkPoint::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(ckfileTemp.c_str(), ckfile.c_str());
-    }
+    VisMF::RenameWhenWritten(ckfileTemp, ckfile);
     ParallelDescriptor::Barrier("Renaming temporary checkPoint file.");
 
   }  // end while
@@ -1718,6 +1763,7 @@ Amr::checkPoint ()
   FArrayBox::setFormat(thePrevFormat);
 
   VisMF::SetHeaderVersion(currentVersion);
+  VisMF::SetCompressionTolerance(currentTolerance);
 
   BL_PROFILE_REGION_STOP("Amr::checkPoint()");
 }
@@ -2249,13 +2295,77 @@ Amr::regrid (int  lbase,
     bool regrid_level_zero = (!initial) &&
         (lbase == 0 && new_grid_places[0] != amr_level[0]->boxArray());
 
+    //
+    // Distribute new grids according to the cost measured on the old ones,
+    // and redistribute unchanged grids whose measured load balance
+    // efficiency has dropped below amr.loadbalance_efficiency.
+    //
+    if (loadbalance_with_cost && !initial && ParallelDescriptor::NProcs() > 1)
+    {
+        for (int lev = (lbase == 0) ? 0 : lbase+1, End = std::min(finest_level,new_finest);
+             lev <= End; ++lev)
+        {
+            if (new_grid_places[lev] != amr_level[lev]->boxArray())
+            {
+                new_dmap[lev] = costDistributionMap(lev, new_grid_places[lev]);
+            }
+            else
+            {
+                const Real eff = DistributionMapping::Efficiency(amr_level[lev]->getCost());
+                if (eff < loadbalance_efficiency)
+                {
+                    Real new_eff = 0;
+                    DistributionMapping dm = costDistributionMap(lev, new_grid_places[lev], &new_eff);
+                    if (!dm.empty() && new_eff > eff)
+                    {
+                        if (verbose > 0) {
+                            amrex::Print() << "Rebalancing level " << lev << ": efficiency "
+                                           << eff << " -> " << new_eff << "\n";
+                        }
+                        new_dmap[lev] = dm;
+                        if (lev == 0) regrid_level_zero = true;
+                    }
+                }
+                //
+                // A level that stays as it is starts measuring afresh, so
+                // that the next check sees the current cost, not the
+                // average since the level was built.
+                //
+                if (new_dmap[lev].empty()) {
+                    amr_level[lev]->getCost().setVal(0.0);
+                }
+            }
+        }
+    }
+
     const int start = regrid_level_zero ? 0 : lbase+1;
 
+    //
+    // Keep the boxes that survive the regrid on their owners, so that
+    // the new levels can take their data instead of copying it.
+    //
+    if (incremental_regrid && !initial)
+    {
+        for (int lev = start, End = std::min(finest_level,new_finest); lev <= End; ++lev)
+        {
+            if (new_dmap[lev].empty() && new_grid_places[lev] != amr_level[lev]->boxArray())
+            {
+                new_dmap[lev] = DistributionMapping::makeKeepOwners(new_grid_places[lev],
+                                                                    amr_level[lev]->boxArray(),
+                                                                    amr_level[lev]->DistributionMap());
+            }
+        }
+    }
+
     bool grids_unchanged = finest_level == new_finest;
     for (int lev = start, End = std::min(finest_level,new_finest); lev <= End; lev++) {
 	if (new_grid_places[lev] == amr_level[lev]->boxArray()) {
 	    new_grid_places[lev] = amr_level[lev]->boxArray();  // to avoid duplicates
-	    new_dmap[lev] = amr_level[lev]->DistributionMap(); 
+	    if (new_dmap[lev].empty()) {
+		new_dmap[lev] = amr_level[lev]->DistributionMap();
+	    } else {
+		grids_unchanged = false;  // rebalanced
+	    }
 	} else {
 	    grids_unchanged = false;
 	}
@@ -2330,6 +2440,14 @@ Amr::regrid (int  lbase,
             // NOTE: The init function may use a filPatch from the old level,
             //       which therefore needs remain in the hierarchy during the call.
             //
+            if (incremental_regrid)
+            {
+                const int nreused = a->reuseStateData(*amr_level[lev]);
+                if (verbose > 0) {
+                    amrex::Print() << "Level " << lev << ": reusing " << nreused << " of "
+                                   << new_grid_places[lev].size() << " grids\n";
+                }
+            }
             a->init(*amr_level[lev]);
             amr_level[lev].reset(a);
 	    this->SetBoxArray(lev, amr_level[lev]->boxArray());
@@ -2426,6 +2544,28 @@ Amr::regrid (int  lbase,
     }
 }
 
+DistributionMapping
+Amr::costDistributionMap (int lev, const BoxArray& ba, Real* efficiency) const
+{
+    const MultiFab& old_cost = amr_level[lev]->getCost();
+
+    const Real total = old_cost.sum(0);
+    if (total <= 0) return DistributionMapping();
+
+    if (ba == old_cost.boxArray()) {
+        return DistributionMapping::makeKnapSack(old_cost, efficiency);
+    }
+
+    //
+    // Cells not covered by the old grids get the mean cost per cell.
+    //
+    MultiFab cost(ba, DistributionMapping(ba), 1, 0);
+    cost.setVal(total/old_cost.boxArray().numPts());
+    cost.ParallelCopy(old_cost);
+
+    return DistributionMapping::makeKnapSack(cost, efficiency);
+}
+
 void
 Amr::regrid_level_0_on_restart()
 {
@@ -2897,6 +3037,11 @@ Amr::initPltAndChk ()
     if(chvInt != checkpoint_headerversion) {
       checkpoint_headerversion = static_cast<VisMF::Header::Version> (chvInt);
     }
+    //
+    // With plot_headerversion = 5 plotfiles may be compressed lossy
+    // to within this error.
+    //
+    pp.query("plot_compression_tolerance", plot_compression_tolerance);
 }
 
 
@@ -56,6 +56,7 @@ AmrLevel::AmrLevel ()
 {
    parent = 0;
    level = -1;
+   reuse_level = 0;
 }
 
 AmrLevel::AmrLevel (Amr&            papa,
@@ -102,6 +103,8 @@ AmrLevel::AmrLevel (Amr&            papa,
 
     post_step_regrid = 0;
 
+    reuse_level = 0;
+
     finishConstructor();
 }
 
@@ -280,13 +283,23 @@ AmrLevel::restart (Amr&          papa,
         fine_ratio = parent->refRatio(level);
     }
 
-    if (bReadSpecial)
-    {
-        amrex::readBoxArray(grids, is, bReadSpecial);
-    }
-    else
+    VisMF::ReadBoxArray(is, grids, papa.theRestartFile(), bReadSpecial);
+
+    if (parent->RedecomposeOnRestart())
     {
-        grids.readFrom(is);
+        //
+        // The same cells, chopped for the current max_grid_size and
+        // number of processes.  StateData::restart reads the checkpoint
+        // data onto them.
+        //
+        BoxList bl(grids);
+        bl.simplify();
+        BoxArray ba(bl);
+        ba.maxSize(parent->maxGridSize(level));
+        if (parent->refineGridLayout()) {
+            parent->ChopGrids(level, ba, ParallelDescriptor::NProcs());
+        }
+        grids = ba;
     }
 
     int nstate;
@@ -328,7 +341,14 @@ AmrLevel::set_state_in_checkpoint (Array<int>& state_in_checkpoint)
 }
 
 void
-AmrLevel::finishConstructor () {}
+AmrLevel::finishConstructor ()
+{
+    if (Amr::loadBalanceWithCost())
+    {
+        m_cost.define(grids, dmap, 1, 0);
+        m_cost.setVal(0.0);
+    }
+}
 
 void
 AmrLevel::setTimeLevel (Real time,
@@ -400,7 +420,7 @@ AmrLevel::checkPoint (const std::string& dir,
     if (ParallelDescriptor::IOProcessor())
     {
         os << level << '\n' << geom  << '\n';
-        grids.writeOn(os);
+        VisMF::WriteBoxArray(os, grids, LevelDir + "/BoxArray", FullPath + "/BoxArray");
         os << ndesc << '\n';
     }
     //
@@ -1973,11 +1993,110 @@ AmrLevel::FillPatch(AmrLevel& amrlevel,
 {
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(boxGrow <= leveldata.nGrow());
+
+    if (amrlevel.reuse_level != 0 && boxGrow == 0 && dcomp == scomp &&
+        &leveldata == &amrlevel.reuse_level->get_new_data(index) &&
+        time == amrlevel.state[index].curTime())
+    {
+        amrlevel.FillPatchReused(leveldata, time, index, scomp, ncomp);
+        return;
+    }
+
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+int
+AmrLevel::reuseStateData (AmrLevel& old)
+{
+    BL_PROFILE("AmrLevel::reuseStateData()");
+
+    const BoxArray&            old_grids = old.boxArray();
+    const DistributionMapping& old_dmap  = old.DistributionMap();
+
+    std::vector<int> boxes(grids.size(), -1);
+    std::vector< std::pair<int,Box> > isects;
+    int nreused = 0;
+
+    for (int i = 0, N = grids.size(); i < N; ++i)
+    {
+        old_grids.intersections(grids[i], isects);
+        for (const auto& is : isects)
+        {
+            if (old_grids[is.first] == grids[i] && old_dmap[is.first] == dmap[i])
+            {
+                boxes[i] = is.first;
+                ++nreused;
+                break;
+            }
+        }
+    }
+
+    old.reuse_level = (nreused > 0) ? this : 0;
+    old.reuse_boxes.swap(boxes);
+
+    return nreused;
+}
+
+//
+// FillPatch of the state data of reuse_level from this level at its new
+// time: take the FABs on the boxes the two levels share, fill the others.
+//
+void
+AmrLevel::FillPatchReused (MultiFab& leveldata,
+                           Real      time,
+                           int       index,
+                           int       scomp,
+                           int       ncomp)
+{
+    BL_PROFILE("AmrLevel::FillPatchReused()");
+
+    MultiFab& old_data = state[index].newData();
+    //
+    // A FAB is taken whole, so only when all of its components are wanted.
+    //
+    const bool whole = (scomp == 0 && ncomp == leveldata.nComp());
+
+    for (MFIter mfi(leveldata); mfi.isValid(); ++mfi)
+    {
+        const int i = mfi.index();
+        const int j = reuse_boxes[i];
+        if (j >= 0 && leveldata[mfi].dataPtr() != old_data[j].dataPtr())
+        {
+            if ( ! whole || ! leveldata.takeFab(i, old_data, j)) {
+                leveldata[mfi].copy(old_data[j], scomp, scomp, ncomp);
+            }
+        }
+    }
+
+    const BoxArray&            ba = leveldata.boxArray();
+    const DistributionMapping& dm = leveldata.DistributionMap();
+
+    BoxList          bl(ba.ixType());
+    Array<int>       pmap;
+    std::vector<int> fill_index;
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        if (reuse_boxes[i] < 0)
+        {
+            bl.push_back(ba[i]);
+            pmap.push_back(dm[i]);
+            fill_index.push_back(i);
+        }
+    }
+
+    if ( ! fill_index.empty())
+    {
+        MultiFab fill(BoxArray(bl), DistributionMapping(pmap), ncomp, 0);
+        FillPatch(*this, fill, 0, time, index, scomp, ncomp, 0);
+        for (MFIter mfi(fill); mfi.isValid(); ++mfi)
+        {
+            leveldata[fill_index[mfi.index()]].copy(fill[mfi], 0, scomp, ncomp);
+        }
+    }
+}
+
 
 
 void
@@ -203,20 +203,27 @@ StateData::restart (std::istream&          is,
         grids.convert(typ);
     }
 
+    bool same_grids = true;
     {
 	Box domain_in;
 	BoxArray grids_in;
 	is >> domain_in;
-	grids_in.readFrom(is);
+	VisMF::ReadBoxArray(is, grids_in, chkfile);
 	BL_ASSERT(domain_in == domain);
-	BL_ASSERT(amrex::match(grids_in,grids));
+	//
+	// With amr.redecompose_on_restart the grids are not those of the
+	// checkpoint, but they cover the same cells.
+	//
+	same_grids = amrex::match(grids_in,grids);
+	BL_ASSERT(same_grids || grids_in.contains(grids,true));
     }
 
-    restartDoit(is, chkfile);
+    restartDoit(is, chkfile, same_grids);
 }
 
 void 
-StateData::restartDoit (std::istream& is, const std::string& chkfile)
+StateData::restartDoit (std::istream& is, const std::string& chkfile,
+                        bool same_grids)
 {
     BL_PROFILE("StateData::restartDoit()");
 
@@ -274,7 +281,11 @@ StateData::restartDoit (std::istream& is, const std::string& chkfile)
 	}
       }
 
-      VisMF::Read(*whichMF, FullPathName, faHeader);
+      if (same_grids) {
+          VisMF::Read(*whichMF, FullPathName, faHeader);
+      } else {
+          VisMF::ReadOnto(*whichMF, FullPathName);
+      }
     }
 }
 
@@ -715,7 +726,7 @@ StateData::checkPoint (const std::string& name,
 
         os << domain << '\n';
 
-        grids.writeOn(os);
+        VisMF::WriteBoxArray(os, grids, name + "_BoxArray", fullpathname + "_BoxArray");
 
         os << old_time.start << '\n'
            << old_time.stop  << '\n'
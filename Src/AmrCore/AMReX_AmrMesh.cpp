@@ -11,6 +11,48 @@ namespace amrex {
 namespace
 {
     bool initialized = false;
+
+    //
+    // The boxes of all ranks, in the order of the ranks.
+    //
+    BoxList
+    AllGatherBoxes (const BoxList& bl)
+    {
+#ifdef BL_USE_MPI
+        const int NProcs = ParallelDescriptor::NProcs();
+        const int IntsPerBox = 2*BL_SPACEDIM;
+
+        std::vector<int> sendbuf;
+        sendbuf.reserve(bl.size()*IntsPerBox);
+        for (const Box& b : bl)
+        {
+            BL_ASSERT(b.ixType().cellCentered());
+            for (int idir = 0; idir < BL_SPACEDIM; ++idir)
+                sendbuf.push_back(b.smallEnd(idir));
+            for (int idir = 0; idir < BL_SPACEDIM; ++idir)
+                sendbuf.push_back(b.bigEnd(idir));
+        }
+
+        int nsend = sendbuf.size();
+        std::vector<int> counts(NProcs), offsets(NProcs,0);
+        MPI_Comm comm = ParallelDescriptor::Communicator();
+        BL_MPI_REQUIRE( MPI_Allgather(&nsend, 1, MPI_INT, counts.data(), 1, MPI_INT, comm) );
+        for (int i = 1; i < NProcs; ++i) {
+            offsets[i] = offsets[i-1] + counts[i-1];
+        }
+        std::vector<int> recvbuf(offsets[NProcs-1] + counts[NProcs-1]);
+        BL_MPI_REQUIRE( MPI_Allgatherv(sendbuf.data(), nsend, MPI_INT,
+                                       recvbuf.data(), counts.data(), offsets.data(), MPI_INT,
+                                       comm) );
+        BoxList r;
+        for (int i = 0, N = recvbuf.size(); i < N; i += IntsPerBox) {
+            r.push_back(Box(IntVect(&recvbuf[i]), IntVect(&recvbuf[i+BL_SPACEDIM])));
+        }
+        return r;
+#else
+        return bl;
+#endif
+    }
 }
 
 void
@@ -56,6 +98,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Array<int>& n_cell_in, std::vector
     verbose   = 0;
     grid_eff  = 0.7;
     n_proper  = 1;
+    distributed_clustering = false;
 
     use_fixed_coarse_grids = false;
     use_fixed_upto_level   = 0;
@@ -99,6 +142,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Array<int>& n_cell_in, std::vector
 
     pp.query("n_proper",n_proper);
     pp.query("grid_eff",grid_eff);
+    pp.query("distributed_clustering",distributed_clustering);
     int cnt = pp.countval("n_error_buf"); 
     if (cnt > 0) {
         pp.getarr("n_error_buf",n_error_buf);
@@ -466,10 +510,16 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
     // Now generate grids from finest level down.
     //
     new_finest = lbase;
+    //
+    // Times of error estimation, of the processing of the tags, of the
+    // clustering and of making the new grids from the clusters.
+    //
+    Real regrid_times[4] = { 0 };
 
     for (int levc = max_crse; levc >= lbase; levc--)
     {
         int levf = levc+1;
+        Real t0 = ParallelDescriptor::second();
         //
         // Construct TagBoxArray with sufficient grow factor to contain
         // new levels projected down to this level.
@@ -501,6 +551,8 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
         if ( ! (useFixedCoarseGrids() && levc < useFixedUpToLevel()) ) {
 	    ErrorEst(levc, tags, time, ngrow);
 	}
+        Real t1 = ParallelDescriptor::second();
+        regrid_times[0] += t1 - t0;
 
         //
         // If new grids have been constructed above this level, project
@@ -614,21 +666,24 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
         // Remove cells outside proper nesting domain for this level.
         //
         tags.setVal(p_n_comp[levc],TagBox::CLEAR);
+        Real t2 = ParallelDescriptor::second();
+        regrid_times[1] += t2 - t1;
         //
-        // Create initial cluster containing all tagged points.
+        // Create initial cluster containing all tagged points.  With
+        // distributed clustering only the tags of this rank, and the
+        // clusters of all ranks are gathered afterwards.
         //
 	std::vector<IntVect> tagvec;
-	tags.collate(tagvec);
+        if (distributed_clustering) {
+            tags.localCollate(tagvec);
+        } else {
+            tags.collate(tagvec);
+        }
         tags.clear();
 
+        BoxList new_bx;
         if (tagvec.size() > 0)
         {
-            //
-            // Created new level, now generate efficient grids.
-            //
-            if ( !(useFixedCoarseGrids() && levc<useFixedUpToLevel()) ) {
-                new_finest = std::max(new_finest,levf);
-	    }
             //
             // Construct initial cluster.
             //
@@ -642,8 +697,31 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
             // Efficient properly nested Clusters have been constructed
             // now generate list of grids at level levf.
             //
-            BoxList new_bx;
             clist.boxList(new_bx);
+        }
+        std::vector<IntVect>().swap(tagvec);
+
+        if (distributed_clustering)
+        {
+            //
+            // Clusters of different ranks overlap where the tag boxes
+            // do.  Whatever covers a tag is kept, so the tags stay
+            // covered and the boxes properly nested.
+            //
+            new_bx = amrex::removeOverlap(AllGatherBoxes(new_bx));
+        }
+        Real t3 = ParallelDescriptor::second();
+        regrid_times[2] += t3 - t2;
+
+        if (new_bx.size() > 0)
+        {
+            //
+            // Created new level, now generate efficient grids.
+            //
+            if ( !(useFixedCoarseGrids() && levc<useFixedUpToLevel()) ) {
+                new_finest = std::max(new_finest,levf);
+	    }
+
             new_bx.refine(bf_lev[levc]);
             new_bx.simplify();
             BL_ASSERT(new_bx.isDisjoint());
@@ -695,8 +773,10 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
               new_grids[levf].define(new_bx);
 	    }
         }
+        regrid_times[3] += ParallelDescriptor::second() - t3;
     }
 
+    Real t4 = ParallelDescriptor::second();
     for (int lev = lbase+1; lev <= new_finest; ++lev) {
         if (new_grids[lev].empty())
         {
@@ -712,6 +792,17 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
             }
         }
     }
+    regrid_times[3] += ParallelDescriptor::second() - t4;
+
+    if (verbose > 0)
+    {
+        ParallelDescriptor::ReduceRealMax(regrid_times,4,ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "MakeNewGrids() times: error estimation " << regrid_times[0]
+                       << " tags " << regrid_times[1]
+                       << " clustering " << regrid_times[2]
+                       << (distributed_clustering ? " (distributed)" : "")
+                       << " grids " << regrid_times[3] << '\n';
+    }
 }
 
 void
@@ -2,6 +2,9 @@
 #include <cstdlib>
 #include <cmath>
 #include <climits>
+#include <cstring>
+#include <cstdint>
+#include <bitset>
 
 #include <AMReX_TagBox.H>
 #include <AMReX_Geometry.H>
@@ -11,6 +14,77 @@
 
 namespace amrex {
 
+namespace
+{
+    //
+    // The tags of a TagBox as one bit per cell: each row in the first
+    // direction is a run of 64-bit words, the rows ordered as the cells.
+    //
+    typedef std::uint64_t TagWord;
+
+    const int TagWordBits = 64;
+
+    //
+    // The number of nonzero bytes in n bytes starting at d.
+    //
+    long
+    CountNonZeroBytes (const char* d, long n)
+    {
+        const TagWord lo7 = UINT64_C(0x7f7f7f7f7f7f7f7f);
+        const TagWord hi1 = UINT64_C(0x8080808080808080);
+
+        long nt = 0;
+        long i  = 0;
+        for ( ; i + 8 <= n; i += 8)
+        {
+            TagWord x;
+            std::memcpy(&x, d+i, sizeof(x));
+            if (x != 0)
+            {
+                //
+                // The high bit of each byte of y is set iff the byte is nonzero.
+                //
+                const TagWord y = (((x & lo7) + lo7) | x) & hi1;
+                nt += std::bitset<64>(y).count();
+            }
+        }
+        for ( ; i < n; ++i) {
+            if (d[i] != 0) ++nt;
+        }
+        return nt;
+    }
+
+    //
+    // dst |= src shifted by s bits, s > 0 toward higher, s < 0 toward
+    // lower cell indices, for rows of nw words.
+    //
+    void
+    OrShifted (TagWord* dst, const TagWord* src, int nw, int s)
+    {
+        if (s > 0)
+        {
+            const int q = s / TagWordBits, r = s % TagWordBits;
+            for (int w = nw-1; w >= q; --w)
+            {
+                TagWord v = src[w-q] << r;
+                if (r > 0 && w-q-1 >= 0) v |= src[w-q-1] >> (TagWordBits-r);
+                dst[w] |= v;
+            }
+        }
+        else if (s < 0)
+        {
+            s = -s;
+            const int q = s / TagWordBits, r = s % TagWordBits;
+            for (int w = 0; w+q < nw; ++w)
+            {
+                TagWord v = src[w+q] >> r;
+                if (r > 0 && w+q+1 < nw) v |= src[w+q+1] << (TagWordBits-r);
+                dst[w] |= v;
+            }
+        }
+    }
+}
+
 TagBox::TagBox () {}
 
 TagBox::TagBox (const Box& bx,
@@ -109,50 +183,127 @@ TagBox::buffer (int nbuff,
     // Note: this routine assumes cell with TagBox::SET tag are in
     // interior of tagbox (region = grow(domain,-nwid)).
     //
+    // Every cell within nbuff cells, in each direction, of a SET cell
+    // is made BUF.  That neighborhood is a box, so it is found with one
+    // dilation per direction of a bitmask of the SET cells: by shifting
+    // the words of each row in the first direction, and by OR-ing whole
+    // rows in the others.
+    //
+    if (nbuff <= 0) return;
+
     Box inside(domain);
     inside.grow(-nwid);
-    const int* inlo = inside.loVect();
-    const int* inhi = inside.hiVect();
-    int klo = 0, khi = 0, jlo = 0, jhi = 0, ilo, ihi;
-    AMREX_D_TERM(ilo=inlo[0]; ihi=inhi[0]; ,
-           jlo=inlo[1]; jhi=inhi[1]; ,
-           klo=inlo[2]; khi=inhi[2];)
+    if (!inside.ok()) return;
 
     IntVect d_length = domain.size();
     const int* len = d_length.getVect();
-    const int* lo = domain.loVect();
-    int ni = 0, nj = 0, nk = 0;
-    AMREX_D_TERM(ni, =nj, =nk) = nbuff;
+    const int* lo  = domain.loVect();
+    const int* inlo = inside.loVect();
+    const int* inhi = inside.hiVect();
+
+    int nj = 1, nk = 1;
+    AMREX_D_TERM(, nj = len[1];, nk = len[2];)
+    const int  nw    = (len[0] + TagWordBits - 1) / TagWordBits;
+    const long nrows = long(nj)*long(nk);
+
+    std::vector<TagWord> mask(nrows*nw, 0);
+    std::vector<TagWord> work(nrows*nw, 0);
+
     TagType* d = dataPtr();
+    //
+    // The SET cells of the interior.
+    //
+    int jlo = 0, jhi = 0, klo = 0, khi = 0;
+    AMREX_D_TERM(, jlo = inlo[1]-lo[1]; jhi = inhi[1]-lo[1];, klo = inlo[2]-lo[2]; khi = inhi[2]-lo[2];)
+    const int ilo = inlo[0]-lo[0], ihi = inhi[0]-lo[0];
 
-#define OFF(i,j,k,lo,len) AMREX_D_TERM(i-lo[0], +(j-lo[1])*len[0] , +(k-lo[2])*len[0]*len[1])
-   
-    for (int k = klo; k <= khi; k++)
+    bool any = false;
+    for (int k = klo; k <= khi; ++k)
     {
-        for (int j = jlo; j <= jhi; j++)
+        for (int j = jlo; j <= jhi; ++j)
         {
-            for (int i = ilo; i <= ihi; i++)
+            const long     row = long(k)*nj + j;
+            const TagType* dr  = d + row*len[0];
+            TagWord*       m   = mask.data() + row*nw;
+            for (int i = ilo; i <= ihi; ++i)
             {
-                TagType* d_check = d + OFF(i,j,k,lo,len);
-                if (*d_check == TagBox::SET)
+                if (dr[i] == TagBox::SET)
                 {
-                    for (int k = -nk; k <= nk; k++)
-                    {
-                        for (int j = -nj; j <= nj; j++)
-                        {
-                            for (int i = -ni; i <= ni; i++)
-                            {
-                                TagType* dn = d_check+ AMREX_D_TERM(i, +j*len[0], +k*len[0]*len[1]);
-                                if (*dn !=TagBox::SET)
-                                    *dn = TagBox::BUF;
-                            }
-                        }
+                    m[i/TagWordBits] |= TagWord(1) << (i%TagWordBits);
+                    any = true;
+                }
+            }
+        }
+    }
+
+    if (!any) return;
+    //
+    // Dilate along the rows.
+    //
+    const int tail = len[0] % TagWordBits;
+    const TagWord tailmask = (tail == 0) ? ~TagWord(0) : ((TagWord(1) << tail) - 1);
+
+    work = mask;
+    for (long row = 0; row < nrows; ++row)
+    {
+        const TagWord* src = mask.data() + row*nw;
+        TagWord*       dst = work.data() + row*nw;
+        for (int s = 1; s <= nbuff; ++s)
+        {
+            OrShifted(dst, src, nw,  s);
+            OrShifted(dst, src, nw, -s);
+        }
+        dst[nw-1] &= tailmask;
+    }
+    mask.swap(work);
+    //
+    // Dilate across the rows in the other directions.
+    //
+#if (BL_SPACEDIM > 1)
+    for (int dir = 1; dir < BL_SPACEDIM; ++dir)
+    {
+        const int  n      = (dir == 1) ? nj : nk;
+        const long stride = (dir == 1) ? long(nw) : long(nw)*nj;
+        const int  nother = (dir == 1) ? nk : nj;
+
+        std::fill(work.begin(), work.end(), TagWord(0));
+        for (int o = 0; o < nother; ++o)
+        {
+            const long base = (dir == 1) ? long(o)*nj*nw : long(o)*nw;
+            for (int a = 0; a < n; ++a)
+            {
+                TagWord* dst = work.data() + base + a*stride;
+                for (int b = std::max(0, a-nbuff), bhi = std::min(n-1, a+nbuff); b <= bhi; ++b)
+                {
+                    const TagWord* src = mask.data() + base + b*stride;
+                    for (int w = 0; w < nw; ++w) {
+                        dst[w] |= src[w];
                     }
                 }
             }
         }
+        mask.swap(work);
+    }
+#endif
+    //
+    // Mark the cells of the dilated mask that are not SET.
+    //
+    for (long row = 0; row < nrows; ++row)
+    {
+        const TagWord* m  = mask.data() + row*nw;
+        TagType*       dr = d + row*len[0];
+        for (int w = 0; w < nw; ++w)
+        {
+            if (m[w] == 0) continue;
+            const int i0 = w*TagWordBits;
+            for (int b = 0; b < TagWordBits && i0+b < len[0]; ++b)
+            {
+                if (((m[w] >> b) & 1) && dr[i0+b] != TagBox::SET) {
+                    dr[i0+b] = TagBox::BUF;
+                }
+            }
+        }
     }
-#undef OFF
 }
 
 void 
@@ -205,23 +356,37 @@ TagBox::merge (const TagBox& src)
 long
 TagBox::numTags () const
 {
-    long nt = 0L;
-    long len = domain.numPts();
-    const TagType* d = dataPtr();
-    for (long n = 0; n < len; ++n)
-    {
-	if (d[n] != TagBox::CLEAR)
-	    ++nt;
-    }
-    return nt;
+    return CountNonZeroBytes(dataPtr(), domain.numPts());
 }
 
 long
 TagBox::numTags (const Box& b) const
 {
-   TagBox tempTagBox(b,1);
-   tempTagBox.copy(*this);
-   return tempTagBox.numTags();
+    const Box bx = b & domain;
+    if (!bx.ok()) return 0L;
+
+    IntVect d_length = domain.size();
+    const int* len = d_length.getVect();
+    const int* lo  = domain.loVect();
+    const int* blo = bx.loVect();
+    const int* bhi = bx.hiVect();
+    const TagType* d = dataPtr();
+
+    int jlo = 0, jhi = 0, klo = 0, khi = 0;
+    AMREX_D_TERM(, jlo = blo[1]; jhi = bhi[1];, klo = blo[2]; khi = bhi[2];)
+
+#define OFF(i,j,k,lo,len) AMREX_D_TERM(i-lo[0], +(j-lo[1])*len[0] , +(k-lo[2])*len[0]*len[1])
+
+    long nt = 0L;
+    for (int k = klo; k <= khi; k++)
+    {
+        for (int j = jlo; j <= jhi; j++)
+        {
+            nt += CountNonZeroBytes(d + OFF(blo[0],j,k,lo,len), bx.length(0));
+        }
+    }
+#undef OFF
+    return nt;
 }
 
 long
@@ -491,9 +656,9 @@ TagBoxArray::numTags () const
 }
 
 void
-TagBoxArray::collate (std::vector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::localCollate (std::vector<IntVect>& TheLocalCollateSpace) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
+    BL_PROFILE("TagBoxArray::localCollate()");
 
     long count = 0;
 
@@ -505,10 +670,7 @@ TagBoxArray::collate (std::vector<IntVect>& TheGlobalCollateSpace) const
         count += get(fai).numTags();
     }
 
-    //
-    // Local space for holding just those tags we want to gather to the root cpu.
-    //
-    std::vector<IntVect> TheLocalCollateSpace(count);
+    TheLocalCollateSpace.resize(count);
 
     count = 0;
 
@@ -526,8 +688,21 @@ TagBoxArray::collate (std::vector<IntVect>& TheGlobalCollateSpace) const
 	std::set<IntVect> tmp (TheLocalCollateSpace.begin(),
 			       TheLocalCollateSpace.end());
 	TheLocalCollateSpace.assign( tmp.begin(), tmp.end() );
-	count = TheLocalCollateSpace.size();
     }
+}
+
+void
+TagBoxArray::collate (std::vector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+    //
+    // Local space for holding just those tags we want to gather to the root cpu.
+    //
+    std::vector<IntVect> TheLocalCollateSpace;
+
+    localCollate(TheLocalCollateSpace);
+
+    long count = TheLocalCollateSpace.size();
     //
     // The total number of tags system wide that must be collated.
     // This is really just an estimate of the upper bound due to duplicates.
@@ -368,6 +368,8 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
 
     ParallelDescriptor::StartTeams();
 
+    ParallelDescriptor::StartNodes();
+
     ParallelDescriptor::StartSubCommunicator();
 
     amrex_mempool_init();
@@ -459,6 +461,8 @@ amrex::Finalize (bool finalize_parallel)
     
     ParallelDescriptor::EndTeams();
 
+    ParallelDescriptor::EndNodes();
+
     ParallelDescriptor::EndSubCommunicator();
 
 #ifdef BL_USE_UPCXX
@@ -1,4 +1,7 @@
 
+#include <cstdlib>
+#include <new>
+
 #include <AMReX_Arena.H>
 #include <AMReX.H>
 
@@ -13,3 +16,26 @@ amrex::Arena::align (std::size_t s)
     x -= x & (align_size-1);
     return x;
 }
+
+void*
+amrex::Arena::heap_alloc (std::size_t sz)
+{
+#ifdef BL_USE_SIMD_FAB
+    void* pt = 0;
+    if (posix_memalign(&pt, align_size, sz == 0 ? align_size : sz) != 0)
+        throw std::bad_alloc();
+    return pt;
+#else
+    return ::operator new(sz);
+#endif
+}
+
+void
+amrex::Arena::heap_free (void* pt)
+{
+#ifdef BL_USE_SIMD_FAB
+    std::free(pt);
+#else
+    ::operator delete(pt);
+#endif
+}
@@ -4,11 +4,11 @@
 void*
 amrex::BArena::alloc (std::size_t _sz)
 {
-    return ::operator new(_sz);
+    return Arena::heap_alloc(_sz);
 }
 
 void
 amrex::BArena::free (void* pt)
 {
-    ::operator delete(pt);
+    Arena::heap_free(pt);
 }
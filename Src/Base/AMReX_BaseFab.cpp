@@ -6,11 +6,16 @@
 #include <AMReX_BaseFab.H>
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
+#include <AMReX_SArena.H>
 
 #if !defined(BL_NO_FORT)
 #include <AMReX_BaseFab_f.H>
 #endif
 
+#ifdef BL_USE_SIMD_FAB
+#include <AMReX_BaseFab_simd.H>
+#endif
+
 #ifdef BL_MEM_PROFILING
 #include <AMReX_MemProfiler.H>
 #endif
@@ -37,6 +42,8 @@ BF_init::BF_init ()
 
 #if defined(BL_COALESCE_FABS)
         the_arena = new CArena;
+#elif defined(BL_SEGREGATE_FABS)
+        the_arena = new SArena;
 #else
         the_arena = new BArena;
 #endif
@@ -57,6 +64,41 @@ BF_init::BF_init ()
 			     return {amrex::TotalBytesAllocatedInFabs(),
 				     amrex::TotalBytesAllocatedInFabsHWM()};
 			 }));
+#if defined(BL_SEGREGATE_FABS)
+	MemProfiler::add("SArena", std::function<MemProfiler::MemInfo()>
+			 ([] () -> MemProfiler::MemInfo {
+			     SArena::Stats s = static_cast<SArena*>(the_arena)->stats();
+			     return {s.heap_bytes, s.heap_bytes};
+			 }));
+	MemProfiler::add("SArena_blocks", std::function<MemProfiler::MemInfo()>
+			 ([] () -> MemProfiler::MemInfo {
+			     SArena::Stats s = static_cast<SArena*>(the_arena)->stats();
+			     return {s.block_bytes, s.block_bytes_hwm};
+			 }));
+	MemProfiler::add("SArena_user", std::function<MemProfiler::MemInfo()>
+			 ([] () -> MemProfiler::MemInfo {
+			     SArena::Stats s = static_cast<SArena*>(the_arena)->stats();
+			     return {s.user_bytes, s.user_bytes_hwm};
+			 }));
+	MemProfiler::add("SArena_free", std::function<MemProfiler::MemInfo()>
+			 ([] () -> MemProfiler::MemInfo {
+			     SArena::Stats s = static_cast<SArena*>(the_arena)->stats();
+			     return {s.free_bytes, s.free_bytes_hwm};
+			 }));
+	//
+	// Free blocks are never split or merged, so report the bytes each
+	// class holds idle.  Only the classes that were used show up.
+	//
+	for (int cls = 0; cls < SArena::NumClasses; ++cls)
+	{
+	    MemProfiler::add("SArena_free_" + std::to_string(SArena::classSize(cls)),
+			     std::function<MemProfiler::MemInfo()>
+			     ([cls] () -> MemProfiler::MemInfo {
+				 std::pair<long,long> f = static_cast<SArena*>(the_arena)->freeBytes(cls);
+				 return {f.first, f.second};
+			     }));
+	}
+#endif
 #endif
     }
 }
@@ -180,10 +222,14 @@ BaseFab<Real>::performCopy (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    simd_fab_copy(*this, destbox, destcomp, src, srcbox, srccomp, numcomp);
+#else
     fort_fab_copy(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
 		  BL_TO_FORTRAN_N_3D(*this,destcomp),
 		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
 		  &numcomp);
+#endif
 }
 
 template <>
@@ -278,9 +324,13 @@ BaseFab<Real>::norm (const Box& bx,
 
     if (p == 0 || p == 1)
     {
+#ifdef BL_USE_SIMD_FAB
+	nrm = simd_fab_norm(*this, bx, comp, ncomp, p);
+#else
 	nrm = fort_fab_norm(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
 			    BL_TO_FORTRAN_N_3D(*this,comp), &ncomp,
 			    &p);
+#endif
     }
     else
     {
@@ -299,8 +349,12 @@ BaseFab<Real>::sum (const Box& bx,
     BL_ASSERT(domain.contains(bx));
     BL_ASSERT(comp >= 0 && comp + ncomp <= nvar);
 
+#ifdef BL_USE_SIMD_FAB
+    return simd_fab_sum(*this, bx, comp, ncomp);
+#else
     return fort_fab_sum(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
 			BL_TO_FORTRAN_N_3D(*this,comp), &ncomp);
+#endif
 }
 
 template<>
@@ -319,10 +373,14 @@ BaseFab<Real>::plus (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    simd_fab_plus(*this, destbox, destcomp, src, srcbox, srccomp, numcomp);
+#else
     fort_fab_plus(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
 		  BL_TO_FORTRAN_N_3D(*this,destcomp),
 		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
 		  &numcomp);
+#endif
 
     return *this;
 }
@@ -343,10 +401,14 @@ BaseFab<Real>::mult (const BaseFab<Real>& src,
     BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    simd_fab_mult(*this, destbox, destcomp, src, srcbox, srccomp, numcomp);
+#else
     fort_fab_mult(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
 		  BL_TO_FORTRAN_N_3D(*this,destcomp),
 		  BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
 		  &numcomp);
+#endif
     return *this;
 }
 
@@ -367,11 +429,15 @@ BaseFab<Real>::saxpy (Real a, const BaseFab<Real>& src,
     BL_ASSERT( srccomp >= 0 &&  srccomp+numcomp <= src.nComp());
     BL_ASSERT(destcomp >= 0 && destcomp+numcomp <=     nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    simd_fab_saxpy(*this, destbox, destcomp, a, src, srcbox, srccomp, numcomp);
+#else
     fort_fab_saxpy(ARLIM_3D(destbox.loVect()), ARLIM_3D(destbox.hiVect()),
 		   BL_TO_FORTRAN_N_3D(*this,destcomp),
 		   &a,
 		   BL_TO_FORTRAN_N_3D(src,srccomp), ARLIM_3D(srcbox.loVect()),
 		   &numcomp);
+#endif
     return *this;
 }
 
@@ -519,11 +585,15 @@ BaseFab<Real>::linComb (const BaseFab<Real>& f1,
     BL_ASSERT(comp2 >= 0 && comp2+numcomp <= f2.nComp());
     BL_ASSERT(comp  >= 0 && comp +numcomp <=    nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    simd_fab_lincomb(*this, b, comp, alpha, f1, b1, comp1, beta, f2, b2, comp2, numcomp);
+#else
     fort_fab_lincomb(ARLIM_3D(b.loVect()), ARLIM_3D(b.hiVect()),
 		     BL_TO_FORTRAN_N_3D(*this,comp),
 		     &alpha, BL_TO_FORTRAN_N_3D(f1,comp1), ARLIM_3D(b1.loVect()),
 		     &beta,  BL_TO_FORTRAN_N_3D(f2,comp2), ARLIM_3D(b2.loVect()),
 		     &numcomp);
+#endif
     return *this;
 }
 
@@ -540,10 +610,14 @@ BaseFab<Real>::dot (const Box& xbx, int xcomp,
     BL_ASSERT(xcomp >= 0 && xcomp+numcomp <=   nComp());
     BL_ASSERT(ycomp >= 0 && ycomp+numcomp <= y.nComp());
 
+#ifdef BL_USE_SIMD_FAB
+    return simd_fab_dot(*this, xbx, xcomp, y, ybx, ycomp, numcomp);
+#else
     return fort_fab_dot(ARLIM_3D(xbx.loVect()), ARLIM_3D(xbx.hiVect()),
 			BL_TO_FORTRAN_N_3D(*this,xcomp),
 			BL_TO_FORTRAN_N_3D(y,ycomp), ARLIM_3D(ybx.loVect()),
 			&numcomp);
+#endif
 }
 
 template<>
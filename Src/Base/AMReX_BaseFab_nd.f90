@@ -417,6 +417,134 @@ contains
   end function fort_fab_dot
 
 
+  ! dst = a*x + b*y + c*z
+  subroutine fort_fab_lincomb3(lo, hi, dst, dlo, dhi, a, x, xlo, xhi, xblo, &
+       b, y, ylo, yhi, yblo, c, z, zlo, zhi, zblo, ncomp) bind(c,name='fort_fab_lincomb3')
+    integer, intent(in) :: lo(3), hi(3), dlo(3), dhi(3), xlo(3), xhi(3), xblo(3), &
+         ylo(3), yhi(3), yblo(3), zlo(3), zhi(3), zblo(3), ncomp
+    real(amrex_real), intent(in   ) :: a, b, c
+    real(amrex_real), intent(inout) :: dst(dlo(1):dhi(1),dlo(2):dhi(2),dlo(3):dhi(3),ncomp)
+    real(amrex_real), intent(in   ) ::   x(xlo(1):xhi(1),xlo(2):xhi(2),xlo(3):xhi(3),ncomp)
+    real(amrex_real), intent(in   ) ::   y(ylo(1):yhi(1),ylo(2):yhi(2),ylo(3):yhi(3),ncomp)
+    real(amrex_real), intent(in   ) ::   z(zlo(1):zhi(1),zlo(2):zhi(2),zlo(3):zhi(3),ncomp)
+
+    integer :: i,j,k,n,xoff(3),yoff(3),zoff(3)
+
+    xoff = xblo - lo
+    yoff = yblo - lo
+    zoff = zblo - lo
+
+    do n = 1, ncomp
+       do       k = lo(3), hi(3)
+          do    j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                dst(i,j,k,n) = a * x(i+xoff(1),j+xoff(2),k+xoff(3),n) &
+                     +         b * y(i+yoff(1),j+yoff(2),k+yoff(3),n) &
+                     +         c * z(i+zoff(1),j+zoff(2),k+zoff(3),n)
+             end do
+          end do
+       end do
+    end do
+  end subroutine fort_fab_lincomb3
+
+
+  ! dst = dst + a*src; returns max(abs(dst))
+  function fort_fab_saxpy_norm0(lo, hi, dst, dlo, dhi, a, src, slo, shi, sblo, ncomp) &
+       result(nrm) bind(c,name='fort_fab_saxpy_norm0')
+    integer, intent(in) :: lo(3), hi(3), dlo(3), dhi(3), slo(3), shi(3), sblo(3), ncomp
+    real(amrex_real), intent(in   ) :: a
+    real(amrex_real), intent(in   ) :: src(slo(1):shi(1),slo(2):shi(2),slo(3):shi(3),ncomp)
+    real(amrex_real), intent(inout) :: dst(dlo(1):dhi(1),dlo(2):dhi(2),dlo(3):dhi(3),ncomp)
+    real(amrex_real) :: nrm
+
+    integer :: i,j,k,n,off(3)
+
+    nrm = 0.0_amrex_real
+
+    off = sblo - lo
+
+    do n = 1, ncomp
+       do       k = lo(3), hi(3)
+          do    j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                dst(i,j,k,n) = dst(i,j,k,n) + a * src(i+off(1),j+off(2),k+off(3),n)
+                nrm = max(nrm, abs(dst(i,j,k,n)))
+             end do
+          end do
+       end do
+    end do
+  end function fort_fab_saxpy_norm0
+
+
+  ! dst = a*x + b*y; returns max(abs(dst))
+  function fort_fab_lincomb_norm0(lo, hi, dst, dlo, dhi, a, x, xlo, xhi, xblo, &
+       b, y, ylo, yhi, yblo, ncomp) result(nrm) bind(c,name='fort_fab_lincomb_norm0')
+    integer, intent(in) :: lo(3), hi(3), dlo(3), dhi(3), xlo(3), xhi(3), xblo(3), &
+         ylo(3), yhi(3), yblo(3), ncomp
+    real(amrex_real), intent(in   ) :: a, b
+    real(amrex_real), intent(inout) :: dst(dlo(1):dhi(1),dlo(2):dhi(2),dlo(3):dhi(3),ncomp)
+    real(amrex_real), intent(in   ) ::   x(xlo(1):xhi(1),xlo(2):xhi(2),xlo(3):xhi(3),ncomp)
+    real(amrex_real), intent(in   ) ::   y(ylo(1):yhi(1),ylo(2):yhi(2),ylo(3):yhi(3),ncomp)
+    real(amrex_real) :: nrm
+
+    integer :: i,j,k,n,xoff(3),yoff(3)
+    real(amrex_real) :: t
+
+    nrm = 0.0_amrex_real
+
+    xoff = xblo - lo
+    yoff = yblo - lo
+
+    do n = 1, ncomp
+       do       k = lo(3), hi(3)
+          do    j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                t = a * x(i+xoff(1),j+xoff(2),k+xoff(3),n) &
+                     + b * y(i+yoff(1),j+yoff(2),k+yoff(3),n)
+                dst(i,j,k,n) = t
+                nrm = max(nrm, abs(t))
+             end do
+          end do
+       end do
+    end do
+  end function fort_fab_lincomb_norm0
+
+
+  ! dp(1) = dot(x,y), dp(2) = dot(x,z)
+  subroutine fort_fab_dot2(lo, hi, x, xlo, xhi, y, ylo, yhi, yblo, z, zlo, zhi, zblo, &
+       ncomp, dp) bind(c,name='fort_fab_dot2')
+    integer, intent(in) :: lo(3), hi(3), xlo(3), xhi(3), ylo(3), yhi(3), yblo(3), &
+         zlo(3), zhi(3), zblo(3), ncomp
+    real(amrex_real), intent(in) :: x(xlo(1):xhi(1),xlo(2):xhi(2),xlo(3):xhi(3),ncomp)
+    real(amrex_real), intent(in) :: y(ylo(1):yhi(1),ylo(2):yhi(2),ylo(3):yhi(3),ncomp)
+    real(amrex_real), intent(in) :: z(zlo(1):zhi(1),zlo(2):zhi(2),zlo(3):zhi(3),ncomp)
+    real(amrex_real), intent(inout) :: dp(2)
+
+    integer :: i,j,k,n,yoff(3),zoff(3)
+    real(amrex_real) :: dxy, dxz
+
+    dxy = 0.0_amrex_real
+    dxz = 0.0_amrex_real
+
+    yoff = yblo - lo
+    zoff = zblo - lo
+
+    do n = 1, ncomp
+       do       k = lo(3), hi(3)
+          do    j = lo(2), hi(2)
+             do i = lo(1), hi(1)
+                dxy = dxy + x(i,j,k,n)*y(i+yoff(1),j+yoff(2),k+yoff(3),n)
+                dxz = dxz + x(i,j,k,n)*z(i+zoff(1),j+zoff(2),k+zoff(3),n)
+             end do
+          end do
+       end do
+    end do
+
+    dp(1) = dxy
+    dp(2) = dxz
+  end subroutine fort_fab_dot2
+
+
   ! dst = src
   subroutine fort_ifab_copy(lo, hi, dst, dlo, dhi, src, slo, shi, sblo, ncomp) &
        bind(c,name='fort_ifab_copy')
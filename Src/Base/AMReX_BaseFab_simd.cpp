@@ -0,0 +1,306 @@
+
+#include <cmath>
+#include <algorithm>
+
+#include <AMReX_BaseFab_simd.H>
+#include <AMReX_BLassert.H>
+
+#if defined(_OPENMP) || defined(BL_USE_SIMD_FAB)
+#define BL_PRAGMA(x) _Pragma(#x)
+#else
+#define BL_PRAGMA(x)
+#endif
+
+#define BL_RESTRICT __restrict__
+
+namespace amrex {
+
+namespace
+{
+    //
+    // The (i,j,k,n) loops over a box in N fabs.  Dimensions in which the
+    // data are contiguous in all N fabs are folded into the innermost
+    // loop, whose length is len[0]; the strides of the outer loops are
+    // kept per fab.
+    //
+    template <int N>
+    struct Loops
+    {
+        Loops (const Box& bx, int numcomp,
+               const BaseFab<Real>* const fab[N], const Box* const box[N], const int comp[N])
+        {
+            for (int d = 0; d < 3; ++d)
+                len[d] = (d < BL_SPACEDIM) ? bx.length(d) : 1;
+            len[3] = numcomp;
+
+            for (int f = 0; f < N; ++f)
+            {
+                const Box& fb = fab[f]->box();
+                BL_ASSERT(fb.contains(*box[f]));
+                BL_ASSERT(box[f]->sameSize(bx));
+
+                long fl[3];
+                for (int d = 0; d < 3; ++d)
+                    fl[d] = (d < BL_SPACEDIM) ? fb.length(d) : 1;
+
+                stride[f][0] = 1;
+                stride[f][1] = fl[0];
+                stride[f][2] = fl[0]*fl[1];
+                stride[f][3] = fl[0]*fl[1]*fl[2];
+
+                long off = 0;
+                for (int d = 0; d < BL_SPACEDIM; ++d)
+                    off += (box[f]->smallEnd(d) - fb.smallEnd(d)) * stride[f][d];
+
+                ptr[f] = const_cast<Real*>(fab[f]->dataPtr(comp[f])) + off;
+            }
+            //
+            // Merge dimension d into the innermost loop while the data
+            // are contiguous across it in every fab.
+            //
+            for (int d = 1; d < 4; ++d)
+            {
+                bool contiguous = true;
+                for (int f = 0; f < N; ++f)
+                    contiguous = contiguous && (stride[f][d] == long(len[0]));
+                if (!contiguous) break;
+                len[0] *= len[d];
+                len[d]  = 1;
+            }
+        }
+
+        //
+        // Call f(p,n) on each run of n contiguous elements; p[f] points
+        // to the start of the run in fab f.
+        //
+        template <class F>
+        void run (F&& f) const
+        {
+            Real* p[N];
+            for (int n = 0; n < len[3]; ++n)
+                for (int k = 0; k < len[2]; ++k)
+                    for (int j = 0; j < len[1]; ++j)
+                    {
+                        for (int i = 0; i < N; ++i)
+                            p[i] = ptr[i] + j*stride[i][1] + k*stride[i][2] + n*stride[i][3];
+                        f(p, len[0]);
+                    }
+        }
+
+        int   len[4];
+        long  stride[N][4];
+        Real* ptr[N];
+    };
+
+    template <class F>
+    void
+    binaryOp (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+              const BaseFab<Real>& src, const Box& srcbox, int srccomp,
+              int numcomp, F&& f)
+    {
+        BL_ASSERT(dstcomp >= 0 && dstcomp+numcomp <= dst.nComp());
+        BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= src.nComp());
+
+        if (!dstbox.ok()) return;
+
+        const BaseFab<Real>* fab[2] = { &dst, &src };
+        const Box*           box[2] = { &dstbox, &srcbox };
+        const int            cmp[2] = { dstcomp, srccomp };
+
+        Loops<2>(dstbox, numcomp, fab, box, cmp).run(f);
+    }
+}
+
+void
+simd_fab_copy (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+               const BaseFab<Real>& src, const Box& srcbox, int srccomp,
+               int numcomp)
+{
+    binaryOp(dst, dstbox, dstcomp, src, srcbox, srccomp, numcomp,
+             [] (Real* const p[], int n)
+    {
+        Real*       BL_RESTRICT d = p[0];
+        const Real* BL_RESTRICT s = p[1];
+        BL_PRAGMA(omp simd)
+        for (int i = 0; i < n; ++i)
+            d[i] = s[i];
+    });
+}
+
+void
+simd_fab_plus (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+               const BaseFab<Real>& src, const Box& srcbox, int srccomp,
+               int numcomp)
+{
+    binaryOp(dst, dstbox, dstcomp, src, srcbox, srccomp, numcomp,
+             [] (Real* const p[], int n)
+    {
+        Real*       BL_RESTRICT d = p[0];
+        const Real* BL_RESTRICT s = p[1];
+        BL_PRAGMA(omp simd)
+        for (int i = 0; i < n; ++i)
+            d[i] += s[i];
+    });
+}
+
+void
+simd_fab_mult (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+               const BaseFab<Real>& src, const Box& srcbox, int srccomp,
+               int numcomp)
+{
+    binaryOp(dst, dstbox, dstcomp, src, srcbox, srccomp, numcomp,
+             [] (Real* const p[], int n)
+    {
+        Real*       BL_RESTRICT d = p[0];
+        const Real* BL_RESTRICT s = p[1];
+        BL_PRAGMA(omp simd)
+        for (int i = 0; i < n; ++i)
+            d[i] *= s[i];
+    });
+}
+
+void
+simd_fab_saxpy (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+                Real a,
+                const BaseFab<Real>& src, const Box& srcbox, int srccomp,
+                int numcomp)
+{
+    binaryOp(dst, dstbox, dstcomp, src, srcbox, srccomp, numcomp,
+             [a] (Real* const p[], int n)
+    {
+        Real*       BL_RESTRICT d = p[0];
+        const Real* BL_RESTRICT s = p[1];
+        BL_PRAGMA(omp simd)
+        for (int i = 0; i < n; ++i)
+            d[i] += a*s[i];
+    });
+}
+
+void
+simd_fab_lincomb (BaseFab<Real>& dst, const Box& dstbox, int dstcomp,
+                  Real a, const BaseFab<Real>& x, const Box& xbox, int xcomp,
+                  Real b, const BaseFab<Real>& y, const Box& ybox, int ycomp,
+                  int numcomp)
+{
+    BL_ASSERT(dstcomp >= 0 && dstcomp+numcomp <= dst.nComp());
+    BL_ASSERT(xcomp   >= 0 && xcomp  +numcomp <=   x.nComp());
+    BL_ASSERT(ycomp   >= 0 && ycomp  +numcomp <=   y.nComp());
+
+    if (!dstbox.ok()) return;
+
+    const BaseFab<Real>* fab[3] = { &dst, &x, &y };
+    const Box*           box[3] = { &dstbox, &xbox, &ybox };
+    const int            cmp[3] = { dstcomp, xcomp, ycomp };
+
+    Loops<3>(dstbox, numcomp, fab, box, cmp).run([a,b] (Real* const p[], int n)
+    {
+        Real*       BL_RESTRICT d  = p[0];
+        const Real* BL_RESTRICT xp = p[1];
+        const Real* BL_RESTRICT yp = p[2];
+        BL_PRAGMA(omp simd)
+        for (int i = 0; i < n; ++i)
+            d[i] = a*xp[i] + b*yp[i];
+    });
+}
+
+Real
+simd_fab_dot (const BaseFab<Real>& x, const Box& xbox, int xcomp,
+              const BaseFab<Real>& y, const Box& ybox, int ycomp,
+              int numcomp)
+{
+    BL_ASSERT(xcomp >= 0 && xcomp+numcomp <= x.nComp());
+    BL_ASSERT(ycomp >= 0 && ycomp+numcomp <= y.nComp());
+
+    Real r = 0;
+
+    if (!xbox.ok()) return r;
+
+    const BaseFab<Real>* fab[2] = { &x, &y };
+    const Box*           box[2] = { &xbox, &ybox };
+    const int            cmp[2] = { xcomp, ycomp };
+
+    Loops<2>(xbox, numcomp, fab, box, cmp).run([&r] (Real* const p[], int n)
+    {
+        const Real* BL_RESTRICT xp = p[0];
+        const Real* BL_RESTRICT yp = p[1];
+        Real s = 0;
+        BL_PRAGMA(omp simd reduction(+:s))
+        for (int i = 0; i < n; ++i)
+            s += xp[i]*yp[i];
+        r += s;
+    });
+
+    return r;
+}
+
+Real
+simd_fab_norm (const BaseFab<Real>& x, const Box& bx, int comp, int numcomp, int p)
+{
+    BL_ASSERT(comp >= 0 && comp+numcomp <= x.nComp());
+    BL_ASSERT(p == 0 || p == 1);
+
+    Real r = 0;
+
+    if (!bx.ok()) return r;
+
+    const BaseFab<Real>* fab[1] = { &x };
+    const Box*           box[1] = { &bx };
+    const int            cmp[1] = { comp };
+
+    Loops<1> loops(bx, numcomp, fab, box, cmp);
+
+    if (p == 0)
+    {
+        loops.run([&r] (Real* const q[], int n)
+        {
+            const Real* BL_RESTRICT xp = q[0];
+            Real s = 0;
+            BL_PRAGMA(omp simd reduction(max:s))
+            for (int i = 0; i < n; ++i)
+                s = std::max(s, std::abs(xp[i]));
+            r = std::max(r, s);
+        });
+    }
+    else
+    {
+        loops.run([&r] (Real* const q[], int n)
+        {
+            const Real* BL_RESTRICT xp = q[0];
+            Real s = 0;
+            BL_PRAGMA(omp simd reduction(+:s))
+            for (int i = 0; i < n; ++i)
+                s += std::abs(xp[i]);
+            r += s;
+        });
+    }
+
+    return r;
+}
+
+Real
+simd_fab_sum (const BaseFab<Real>& x, const Box& bx, int comp, int numcomp)
+{
+    BL_ASSERT(comp >= 0 && comp+numcomp <= x.nComp());
+
+    Real r = 0;
+
+    if (!bx.ok()) return r;
+
+    const BaseFab<Real>* fab[1] = { &x };
+    const Box*           box[1] = { &bx };
+    const int            cmp[1] = { comp };
+
+    Loops<1>(bx, numcomp, fab, box, cmp).run([&r] (Real* const q[], int n)
+    {
+        const Real* BL_RESTRICT xp = q[0];
+        Real s = 0;
+        BL_PRAGMA(omp simd reduction(+:s))
+        for (int i = 0; i < n; ++i)
+            s += xp[i];
+        r += s;
+    });
+
+    return r;
+}
+
+}
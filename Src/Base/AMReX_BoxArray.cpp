@@ -26,6 +26,71 @@ bool BoxArray::initialized = false;
 
 namespace {
     const int bl_ignore_max = 100000;
+
+    //
+    // Calls f(index) for the boxes in the bins of a hash level that a box
+    // (already in the index space of the BoxArray) may intersect, until f
+    // returns false.  If there are more bins to look at than there are
+    // filled ones, just go through the filled ones.
+    //
+    template <class F>
+    bool
+    forEachInBins (const BARef::HashLevel& level, const Box& bx, F&& f)
+    {
+        const Box& gbx = amrex::coarsen(bx, level.crsn);
+
+        const IntVect& sm = amrex::max(gbx.smallEnd()-1, level.bbox.smallEnd());
+        const IntVect& bg = amrex::min(gbx.bigEnd(),     level.bbox.bigEnd());
+
+        Box cbx(sm,bg);
+        cbx.normalize();
+
+        if (!cbx.intersects(level.bbox)) return true;
+
+        if (cbx.numPts() > static_cast<long>(level.hash.size()))
+        {
+            for (const auto& kv : level.hash)
+            {
+                if (cbx.contains(kv.first))
+                {
+                    for (const int index : kv.second) {
+                        if (!f(index)) return false;
+                    }
+                }
+            }
+        }
+        else
+        {
+            auto TheEnd = level.hash.cend();
+
+            for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
+            {
+                auto it = level.hash.find(iv);
+
+                if (it != TheEnd)
+                {
+                    for (const int index : it->second) {
+                        if (!f(index)) return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //
+    // Boxes are grouped by the power of four their longest side is
+    // smaller than the longest side of all by.  Finer groups cost more in
+    // lookups than they save unless box sizes vary a lot.
+    //
+    int
+    sizeClass (const Box& bx, int maxside)
+    {
+        int c = 0;
+        for (int len = bx.longside()*4; len <= maxside; len *= 4) ++c;
+        return c;
+    }
 }
 
 BARef::BARef () 
@@ -175,10 +240,12 @@ void
 BARef::updateMemoryUsage_hash (int s)
 {
     if (hash.size() > 0) {
-	long b = sizeof(hash);
-	for (const auto& x: hash) {
-	    b += amrex::gcc_map_node_extra_bytes
-		+ sizeof(IntVect) + amrex::bytesOf(x.second);
+	long b = sizeof(hash) + hash.size()*sizeof(HashLevel);
+	for (const auto& level : hash) {
+	    for (const auto& x: level.hash) {
+		b += amrex::gcc_map_node_extra_bytes
+		    + sizeof(IntVect) + amrex::bytesOf(x.second);
+	    }
 	}
 	if (s > 0) {
 	    total_hash_bytes += b;
@@ -901,7 +968,7 @@ BoxArray::intersections (const Box&                         bx,
 {
     // called too many times  BL_PROFILE("BoxArray::intersections()");
 
-    BARef::HashType& BoxHashMap = getHashMap();
+    const std::vector<BARef::HashLevel>& BoxHashMap = getHashMap();
 
     isects.resize(0);
 
@@ -917,35 +984,23 @@ BoxArray::intersections (const Box&                         bx,
 	const IntVect& doihi = getDoiHi();
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-        gbx.refine(m_crse_ratio).coarsen(m_ref->crsn);
-	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-        const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
-
-        Box cbx(sm,bg);
-        cbx.normalize();
+        gbx.refine(m_crse_ratio);
 
-	if (!cbx.intersects(m_ref->bbox)) return;
-
-	auto TheEnd = BoxHashMap.cend();
-
-        for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
+        auto f = [&] (int index) -> bool
         {
-            auto it = BoxHashMap.find(iv);
+            const Box& isect = bx & amrex::grow((*this)[index],ng);
 
-            if (it != TheEnd)
+            if (isect.ok())
             {
-                for (const int index : it->second)
-                {
-                    const Box& isect = bx & amrex::grow((*this)[index],ng);
-
-                    if (isect.ok())
-                    {
-                        isects.push_back(std::pair<int,Box>(index,isect));
-			if (first_only) return;
-                    }
-                }
+                isects.push_back(std::pair<int,Box>(index,isect));
+                if (first_only) return false;
             }
+            return true;
+        };
+
+        for (const auto& level : BoxHashMap)
+        {
+            if (!forEachInBins(level, gbx, f)) return;
         }
     }
 }
@@ -957,7 +1012,7 @@ BoxArray::complementIn (const Box& bx) const
 
     if (!empty()) 
     {
-	BARef::HashType& BoxHashMap = getHashMap();
+	const std::vector<BARef::HashLevel>& BoxHashMap = getHashMap();
 
 	BL_ASSERT(bx.ixType() == ixType());
 
@@ -969,43 +1024,29 @@ BoxArray::complementIn (const Box& bx) const
 	const IntVect& doihi = getDoiHi();
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-        gbx.refine(m_crse_ratio).coarsen(m_ref->crsn);
-	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-        const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
-
-        Box cbx(sm,bg);
-        cbx.normalize();
-
-	if (!cbx.intersects(m_ref->bbox)) return bl;
-
-	auto TheEnd = BoxHashMap.cend();
+        gbx.refine(m_crse_ratio);
 
         BoxList newbl(bl.ixType());
 
-	for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); 
-	     iv <= End && bl.isNotEmpty(); 
-	     cbx.next(iv))
+        auto f = [&] (int index) -> bool
         {
-            auto it = BoxHashMap.find(iv);
+            const Box& isect = bx & (*this)[index];
 
-            if (it != TheEnd)
+            if (isect.ok())
             {
-                for (const int index : it->second)
-                {
-                    const Box& isect = bx & (*this)[index];
-
-                    if (isect.ok())
-                    {
-                        newbl.clear();
-                        for (const Box& b : bl) {
-                            const BoxList& diff = amrex::boxDiff(b, isect);
-                            newbl.join(diff);
-                        }
-                        std::swap(bl,newbl);
-                    }
+                newbl.clear();
+                for (const Box& b : bl) {
+                    const BoxList& diff = amrex::boxDiff(b, isect);
+                    newbl.join(diff);
                 }
+                std::swap(bl,newbl);
             }
+            return bl.isNotEmpty();
+        };
+
+        for (const auto& level : BoxHashMap)
+        {
+            if (!forEachInBins(level, gbx, f)) break;
         }
     }
 
@@ -1040,7 +1081,7 @@ BoxArray::removeOverlap (bool simplify)
 
     uniqify();
 
-    BARef::HashType& BoxHashMap = m_ref->hash;
+    std::vector<BARef::HashLevel>& BoxHashMap = getHashMap();
 
     const Box EmptyBox;
 
@@ -1072,7 +1113,20 @@ BoxArray::removeOverlap (bool simplify)
                 for (const Box& b : bl)
                 {
                     m_ref->m_abox.push_back(b);
-                    BoxHashMap[amrex::coarsen(b.smallEnd(),m_ref->crsn)].push_back(size()-1);
+                    //
+                    // The piece fits in the bins of the level of the box it
+                    // was cut from, if not in those of a finer one.
+                    //
+                    for (auto it = BoxHashMap.rbegin(); it != BoxHashMap.rend(); ++it)
+                    {
+                        BARef::HashLevel& level = *it;
+                        const IntVect& iv = amrex::coarsen(b.smallEnd(),level.crsn);
+                        if (b.size().allLE(level.crsn) && level.bbox.contains(iv))
+                        {
+                            level.hash[iv].push_back(size()-1);
+                            break;
+                        }
+                    }
                 }
             }
         }
@@ -1159,10 +1213,10 @@ BoxArray::getDoiHi () const
     return m_simple ?           m_typ.ixType() : m_transformer->doiHi();
 }
 
-BARef::HashType&
+std::vector<BARef::HashLevel>&
 BoxArray::getHashMap () const
 {
-    BARef::HashType& BoxHashMap = m_ref->hash;
+    std::vector<BARef::HashLevel>& BoxHashMap = m_ref->hash;
 
 #ifdef _OPENMP
     #pragma omp critical(intersections_lock)
@@ -1171,29 +1225,76 @@ BoxArray::getHashMap () const
         if (BoxHashMap.empty() && size() > 0)
         {
             //
-            // Calculate the bounding box & maximum extent of the boxes.
+            // Find the size classes of the boxes, and the bounding box &
+            // maximum extent of the boxes in each of them.
             //
-	    IntVect maxext = IntVect::TheUnitVector();
-            Box boundingbox = m_ref->m_abox[0];
-
 	    const int N = size();
+            std::vector<int> cls(N);
+            std::map<int,int> levelOf;
+
+            int maxside = 0;
+	    for (int i = 0; i < N; ++i)
+            {
+                maxside = std::max(maxside, m_ref->m_abox[i].longside());
+            }
+
+	    for (int i = 0; i < N; ++i)
+            {
+                cls[i] = sizeClass(m_ref->m_abox[i], maxside);
+                ++levelOf[cls[i]];
+            }
+            //
+            // Order the levels from the largest boxes down.  A class of
+            // smaller boxes only gets a level of its own if it outnumbers
+            // the boxes of the level it would otherwise share.
+            //
+            int nlevs = 0, nboxes = 0;
+            for (auto& kv : levelOf)
+            {
+                if (nlevs == 0 || kv.second > nboxes)
+                {
+                    ++nlevs;
+                    nboxes = 0;
+                }
+                nboxes += kv.second;
+                kv.second = nlevs-1;
+            }
+            for (auto& c : cls) c = levelOf[c];
+
+            BoxHashMap.resize(nlevs);
+            std::vector<bool> first(nlevs, true);
+
 	    for (int i = 0; i < N; ++i)
             {
                 const Box& bx = m_ref->m_abox[i];
-                maxext = amrex::max(maxext, bx.size());
-                boundingbox.minBox(bx);
+                const int lev = cls[i];
+                BARef::HashLevel& level = BoxHashMap[lev];
+                if (first[lev])
+                {
+                    first[lev] = false;
+                    level.crsn = bx.size();
+                    level.bbox = bx;
+                }
+                else
+                {
+                    level.crsn = amrex::max(level.crsn, bx.size());
+                    level.bbox.minBox(bx);
+                }
             }
 
             for (int i = 0; i < N; i++)
             {
+                BARef::HashLevel& level = BoxHashMap[cls[i]];
                 const IntVect& crsnsmlend 
-		    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),maxext);
-                BoxHashMap[crsnsmlend].push_back(i);
+		    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),level.crsn);
+                level.hash[crsnsmlend].push_back(i);
             }
 
-            m_ref->crsn = maxext;
-            m_ref->bbox =boundingbox.coarsen(maxext);
-            m_ref->bbox.normalize();
+            for (auto& level : BoxHashMap)
+            {
+                level.bbox.coarsen(level.crsn);
+                level.bbox.normalize();
+            }
 
 #ifdef BL_MEM_PROFILING
 	    m_ref->updateMemoryUsage_hash(1);
@@ -21,7 +21,7 @@ CArena::CArena (size_t hunk_size)
 CArena::~CArena ()
 {
     for (unsigned int i = 0, N = m_alloc.size(); i < N; i++)
-        ::operator delete(m_alloc[i]);
+        Arena::heap_free(m_alloc[i]);
 }
 
 void*
@@ -43,7 +43,7 @@ CArena::alloc (size_t nbytes)
     {
         const size_t N = nbytes < m_hunk ? m_hunk : nbytes;
 
-        vp = ::operator new(N);
+        vp = Arena::heap_alloc(N);
 
         m_used += N;
 
@@ -2592,7 +2592,7 @@ DistributionMapping::TranslateProcMap(const Array<int> &pm_old, const MPI_Group
 #endif
 
 DistributionMapping
-DistributionMapping::makeKnapSack (const MultiFab& weight)
+DistributionMapping::makeKnapSack (const MultiFab& weight, Real* efficiency)
 {
     DistributionMapping r;
 
@@ -2624,6 +2624,8 @@ DistributionMapping::makeKnapSack (const MultiFab& weight)
 
     r.KnapSackProcessorMap(cost, nprocs, &eff, true);
 
+    if (efficiency) *efficiency = eff;
+
     return r;
 }
 
@@ -2698,6 +2700,78 @@ DistributionMapping::makeSFC (const MultiFab& weight,
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeKeepOwners (const BoxArray& boxes,
+                                     const BoxArray& old_boxes,
+                                     const DistributionMapping& old_dm,
+                                     int* nkept)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int N = boxes.size();
+
+    Array<int> pmap(N, -1);
+    std::vector<long> load(nprocs, 0);
+    std::vector<LIpair> rest;
+    std::vector< std::pair<int,Box> > isects;
+    int kept = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = boxes[i];
+        old_boxes.intersections(bx, isects);
+        for (const auto& is : isects)
+        {
+            if (old_boxes[is.first] == bx)
+            {
+                pmap[i] = old_dm[is.first];
+                load[pmap[i]] += bx.numPts();
+                ++kept;
+                break;
+            }
+        }
+        if (pmap[i] < 0) {
+            rest.push_back(LIpair(bx.numPts(), i));
+        }
+    }
+
+    Sort(rest, true);
+
+    std::priority_queue<LIpair, std::vector<LIpair>, LIpairGT> procs;
+    for (int i = 0; i < nprocs; ++i) {
+        procs.push(LIpair(load[i], i));
+    }
+    for (const LIpair& b : rest)
+    {
+        LIpair p = procs.top();
+        procs.pop();
+        pmap[b.second] = p.second;
+        p.first += b.first;
+        procs.push(p);
+    }
+
+    if (nkept) *nkept = kept;
+
+    return DistributionMapping(pmap);
+}
+
+Real
+DistributionMapping::Efficiency (const MultiFab& weight)
+{
+    Real local = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:local)
+#endif
+    for (MFIter mfi(weight); mfi.isValid(); ++mfi) {
+        local += weight[mfi].sum(mfi.validbox(),0);
+    }
+
+    Real sum_weight = local, max_weight = local;
+    ParallelDescriptor::ReduceRealSum(sum_weight);
+    ParallelDescriptor::ReduceRealMax(max_weight);
+
+    return (max_weight > 0) ? sum_weight/(ParallelDescriptor::NProcs()*max_weight) : 1.0;
+}
+
 std::ostream&
 operator<< (std::ostream&              os,
             const DistributionMapping& pmap)
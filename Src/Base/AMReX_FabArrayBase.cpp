@@ -4,6 +4,11 @@
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
 
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <tuple>
+
 #ifdef BL_MEM_PROFILING
 #include <AMReX_MemProfiler.H>
 #endif
@@ -14,6 +19,8 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 bool    FabArrayBase::do_async_sends;
+bool    FabArrayBase::use_persistent_fb;
+bool    FabArrayBase::node_aware;
 int     FabArrayBase::MaxComp;
 #if BL_SPACEDIM == 1
 IntVect FabArrayBase::mfiter_tile_size(1024000);
@@ -29,12 +36,16 @@ int FabArrayBase::nFabArrays(0);
 
 FabArrayBase::TACache              FabArrayBase::m_TheTileArrayCache;
 FabArrayBase::FBCache              FabArrayBase::m_TheFBCache;
+FabArrayBase::FBPlanCache          FabArrayBase::m_TheFBPlanCache;
+FabArrayBase::NodePlanCache        FabArrayBase::m_TheNodePlanCache;
 FabArrayBase::CPCache              FabArrayBase::m_TheCPCache;
 FabArrayBase::FPinfoCache          FabArrayBase::m_TheFillPatchCache;
 FabArrayBase::CFinfoCache          FabArrayBase::m_TheCrseFineCache;
 
 FabArrayBase::CacheStats           FabArrayBase::m_TAC_stats("TileArrayCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FBC_stats("FBCache");
+FabArrayBase::CacheStats           FabArrayBase::m_FBP_stats("FBPlanCache");
+FabArrayBase::CacheStats           FabArrayBase::m_NP_stats("NodePlanCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CPC_stats("CopyCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FPinfo_stats("FillPatchCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CFinfo_stats("CrseFineCache");
@@ -71,6 +82,8 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::do_async_sends    = true;
+    FabArrayBase::use_persistent_fb = false;
+    FabArrayBase::node_aware        = false;
     FabArrayBase::MaxComp           = 25;
 
     ParmParse pp("fabarray");
@@ -94,6 +107,8 @@ FabArrayBase::Initialize ()
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
     pp.query("do_async_sends",      FabArrayBase::do_async_sends);
+    pp.query("use_persistent_fb",   FabArrayBase::use_persistent_fb);
+    pp.query("node_aware",          FabArrayBase::node_aware);
 
     if (MaxComp < 1)
         MaxComp = 1;
@@ -111,6 +126,14 @@ FabArrayBase::Initialize ()
 		     ([] () -> MemProfiler::MemInfo {
 			 return {m_FBC_stats.bytes, m_FBC_stats.bytes_hwm};
 		     }));
+    MemProfiler::add(m_FBP_stats.name, std::function<MemProfiler::MemInfo()>
+		     ([] () -> MemProfiler::MemInfo {
+			 return {m_FBP_stats.bytes, m_FBP_stats.bytes_hwm};
+		     }));
+    MemProfiler::add(m_NP_stats.name, std::function<MemProfiler::MemInfo()>
+		     ([] () -> MemProfiler::MemInfo {
+			 return {m_NP_stats.bytes, m_NP_stats.bytes_hwm};
+		     }));
     MemProfiler::add(m_CPC_stats.name, std::function<MemProfiler::MemInfo()>
 		     ([] () -> MemProfiler::MemInfo {
 			 return {m_CPC_stats.bytes, m_CPC_stats.bytes_hwm};
@@ -278,6 +301,7 @@ FabArrayBase::CPC::CPC (const BoxArray& dstba, const DistributionMapping& dstdm,
 
 FabArrayBase::CPC::~CPC ()
 {
+    flushNodePlans(this);
     delete m_LocTags;
     delete m_SndTags;
     delete m_RcvTags;
@@ -493,6 +517,7 @@ FabArrayBase::flushCPC (bool no_assertion) const
 void
 FabArrayBase::flushCPCache ()
 {
+    flushNodePlanCache();
     for (CPCacheIter it = m_TheCPCache.begin(); it != m_TheCPCache.end(); ++it)
     {
 	if (it->first == it->second->m_srcbdk) {
@@ -975,6 +1000,7 @@ FabArrayBase::FB::define_epo (const FabArrayBase& fa)
 
 FabArrayBase::FB::~FB ()
 {
+    flushNodePlans(this);
     delete m_LocTags;
     delete m_SndTags;
     delete m_RcvTags;
@@ -986,6 +1012,8 @@ void
 FabArrayBase::flushFB (bool no_assertion) const
 {
     BL_ASSERT(no_assertion || getBDKey() == m_bdkey);
+    // Plans point to FBs.  So they must go first.
+    flushFBPlan(no_assertion);
     std::pair<FBCacheIter,FBCacheIter> er_it = m_TheFBCache.equal_range(m_bdkey);
     for (FBCacheIter it = er_it.first; it != er_it.second; ++it)
     {
@@ -1001,6 +1029,8 @@ FabArrayBase::flushFB (bool no_assertion) const
 void
 FabArrayBase::flushFBCache ()
 {
+    flushFBPlanCache();
+    flushNodePlanCache();
     for (FBCacheIter it = m_TheFBCache.begin(); it != m_TheFBCache.end(); ++it)
     {
 	m_FBC_stats.recordErase(it->second->m_nuse);
@@ -1051,6 +1081,498 @@ FabArrayBase::getFB (const Periodicity& period, bool cross, bool enforce_periodi
     return *new_fb;
 }
 
+FabArrayBase::FBPlan::FBPlan (const FB& fb, int ncomp, int value_size, int tag)
+    : m_fb(&fb), m_ncomp(ncomp), m_value_size(value_size), m_tag(tag), m_busy(false),
+      m_the_send_data(nullptr), m_the_recv_data(nullptr), m_nuse(0)
+{
+    BL_PROFILE("FabArrayBase::FBPlan::FBPlan()");
+
+    const std::size_t bytes_per_cell = static_cast<std::size_t>(ncomp) * value_size;
+
+    std::size_t TotalSndsVolume = 0;
+    for (const auto& kv : *fb.m_SndTags) // loop over receivers
+    {
+        std::size_t nbytes = 0;
+        for (const auto& cct : kv.second)
+        {
+            m_send_tags.push_back(&cct);
+            m_send_offset.push_back(TotalSndsVolume + nbytes);
+            nbytes += cct.sbox.numPts() * bytes_per_cell;
+        }
+
+        BL_ASSERT(nbytes < std::numeric_limits<int>::max());
+
+        if (nbytes > 0)
+        {
+            m_send_rank.push_back(kv.first);
+            m_send_size.push_back(static_cast<int>(nbytes));
+            TotalSndsVolume += nbytes;
+        }
+    }
+
+    std::size_t TotalRcvsVolume = 0;
+    for (const auto& kv : *fb.m_RcvTags) // loop over senders
+    {
+        std::size_t nbytes = 0;
+        for (const auto& cct : kv.second)
+        {
+            m_recv_tags.push_back(&cct);
+            m_recv_offset.push_back(TotalRcvsVolume + nbytes);
+            nbytes += cct.dbox.numPts() * bytes_per_cell;
+        }
+
+        BL_ASSERT(nbytes < std::numeric_limits<int>::max());
+
+        if (nbytes > 0)
+        {
+            m_recv_rank.push_back(kv.first);
+            m_recv_size.push_back(static_cast<int>(nbytes));
+            TotalRcvsVolume += nbytes;
+        }
+    }
+
+    if (TotalSndsVolume > 0) {
+        m_the_send_data = static_cast<char*>(amrex::The_Arena()->alloc(TotalSndsVolume));
+    }
+    if (TotalRcvsVolume > 0) {
+        m_the_recv_data = static_cast<char*>(amrex::The_Arena()->alloc(TotalRcvsVolume));
+    }
+
+#ifdef BL_USE_MPI
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    const int nsend = m_send_rank.size();
+    m_send_reqs.resize(nsend, MPI_REQUEST_NULL);
+    std::size_t offset = 0;
+    for (int i = 0; i < nsend; ++i)
+    {
+        BL_MPI_REQUIRE( MPI_Send_init(m_the_send_data+offset, m_send_size[i], MPI_CHAR,
+                                      m_send_rank[i], m_tag, comm, &m_send_reqs[i]) );
+        offset += m_send_size[i];
+    }
+
+    const int nrecv = m_recv_rank.size();
+    m_recv_reqs.resize(nrecv, MPI_REQUEST_NULL);
+    offset = 0;
+    for (int i = 0; i < nrecv; ++i)
+    {
+        BL_MPI_REQUIRE( MPI_Recv_init(m_the_recv_data+offset, m_recv_size[i], MPI_CHAR,
+                                      m_recv_rank[i], m_tag, comm, &m_recv_reqs[i]) );
+        offset += m_recv_size[i];
+    }
+#endif
+}
+
+FabArrayBase::FBPlan::~FBPlan ()
+{
+    BL_ASSERT(!m_busy);
+#ifdef BL_USE_MPI
+    for (auto& req : m_send_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+    for (auto& req : m_recv_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+#endif
+    if (m_the_send_data) amrex::The_Arena()->free(m_the_send_data);
+    if (m_the_recv_data) amrex::The_Arena()->free(m_the_recv_data);
+    ParallelDescriptor::ReleasePersistentTag(m_tag);
+}
+
+long
+FabArrayBase::FBPlan::bytes () const
+{
+    long cnt = sizeof(FabArrayBase::FBPlan);
+
+    cnt += std::accumulate(m_send_size.begin(), m_send_size.end(), 0L);
+    cnt += std::accumulate(m_recv_size.begin(), m_recv_size.end(), 0L);
+
+    cnt += amrex::bytesOf(m_send_rank) + amrex::bytesOf(m_send_size)
+        +  amrex::bytesOf(m_recv_rank) + amrex::bytesOf(m_recv_size)
+        +  amrex::bytesOf(m_send_tags) + amrex::bytesOf(m_send_offset)
+        +  amrex::bytesOf(m_recv_tags) + amrex::bytesOf(m_recv_offset);
+
+    return cnt;
+}
+
+FabArrayBase::FBPlan*
+FabArrayBase::getFBPlan (const FB& fb, int ncomp, int value_size) const
+{
+    BL_PROFILE("FabArrayBase::getFBPlan()");
+
+    BL_ASSERT(getBDKey() == m_bdkey);
+    std::pair<FBPlanCacheIter,FBPlanCacheIter> er_it = m_TheFBPlanCache.equal_range(m_bdkey);
+    for (FBPlanCacheIter it = er_it.first; it != er_it.second; ++it)
+    {
+        if (it->second->m_fb         == &fb   &&
+            it->second->m_ncomp      == ncomp &&
+            it->second->m_value_size == value_size)
+        {
+            ++(it->second->m_nuse);
+            m_FBP_stats.recordUse();
+            return it->second;
+        }
+    }
+
+    // Have to build a new one, unless we have run out of tags.
+    const int tag = ParallelDescriptor::PersistentTag();
+    if (tag < 0) return nullptr;
+
+    FBPlan* new_plan = new FBPlan(fb, ncomp, value_size, tag);
+
+#ifdef BL_MEM_PROFILING
+    m_FBP_stats.bytes += new_plan->bytes();
+    m_FBP_stats.bytes_hwm = std::max(m_FBP_stats.bytes_hwm, m_FBP_stats.bytes);
+#endif
+
+    new_plan->m_nuse = 1;
+    m_FBP_stats.recordBuild();
+    m_FBP_stats.recordUse();
+
+    m_TheFBPlanCache.insert(er_it.second, FBPlanCache::value_type(m_bdkey,new_plan));
+
+    return new_plan;
+}
+
+void
+FabArrayBase::flushFBPlan (bool no_assertion) const
+{
+    BL_ASSERT(no_assertion || getBDKey() == m_bdkey);
+    std::pair<FBPlanCacheIter,FBPlanCacheIter> er_it = m_TheFBPlanCache.equal_range(m_bdkey);
+    for (FBPlanCacheIter it = er_it.first; it != er_it.second; ++it)
+    {
+#ifdef BL_MEM_PROFILING
+	m_FBP_stats.bytes -= it->second->bytes();
+#endif
+	m_FBP_stats.recordErase(it->second->m_nuse);
+	delete it->second;
+    }
+    m_TheFBPlanCache.erase(er_it.first, er_it.second);
+}
+
+void
+FabArrayBase::flushFBPlanCache ()
+{
+    for (FBPlanCacheIter it = m_TheFBPlanCache.begin(); it != m_TheFBPlanCache.end(); ++it)
+    {
+	m_FBP_stats.recordErase(it->second->m_nuse);
+	delete it->second;
+    }
+    m_TheFBPlanCache.clear();
+#ifdef BL_MEM_PROFILING
+    m_FBP_stats.bytes = 0L;
+#endif
+}
+
+FabArrayBase::NodePlan::NodePlan (const void* owner,
+                                  const MapOfCopyComTagContainers& snd_tags,
+                                  const MapOfCopyComTagContainers& rcv_tags,
+                                  bool threadsafe_rcv, int ncomp, int value_size, int tag)
+    : m_owner(owner), m_id(0), m_ncomp(ncomp), m_value_size(value_size), m_tag(tag),
+      m_threadsafe_rcv(threadsafe_rcv), m_busy(false), m_agg_recv(false),
+      m_the_send_data(nullptr), m_the_recv_data(nullptr),
+#ifdef BL_USE_MPI3
+      m_win(MPI_WIN_NULL),
+#endif
+      m_nuse(0)
+{
+    BL_PROFILE("FabArrayBase::NodePlan::NodePlan()");
+
+#ifdef BL_USE_MPI3
+    const int MyProc = ParallelDescriptor::MyProc();
+    const int MyNode = ParallelDescriptor::MyNode();
+    const int NSize  = ParallelDescriptor::NodeSize();
+
+    const std::size_t bytes_per_cell = static_cast<std::size_t>(ncomp) * value_size;
+
+    //
+    // The off-node messages of this rank as (source, destination, bytes).
+    //
+    Array<long> mine;
+    for (const auto& kv : snd_tags) // loop over receivers
+    {
+        if (ParallelDescriptor::sameNode(kv.first)) continue; // They read our fabs.
+
+        long nbytes = 0;
+        for (const auto& cct : kv.second) {
+            nbytes += cct.sbox.numPts() * bytes_per_cell;
+        }
+        mine.push_back(MyProc);
+        mine.push_back(kv.first);
+        mine.push_back(nbytes);
+    }
+    for (const auto& kv : rcv_tags) // loop over senders
+    {
+        if (ParallelDescriptor::sameNode(kv.first))
+        {
+            for (const auto& cct : kv.second) {
+                m_node_tags.push_back(&cct);
+            }
+            continue;
+        }
+
+        long nbytes = 0;
+        for (const auto& cct : kv.second) {
+            nbytes += cct.dbox.numPts() * bytes_per_cell;
+        }
+        mine.push_back(kv.first);
+        mine.push_back(MyProc);
+        mine.push_back(nbytes);
+    }
+
+    //
+    // Gather the off-node messages of the whole node.
+    //
+    const MPI_Comm node_comm = ParallelDescriptor::CommunicatorNode();
+
+    Array<int> cnts(NSize), disps(NSize,0);
+    int nmine = mine.size();
+    BL_MPI_REQUIRE( MPI_Allgather(&nmine, 1, MPI_INT, cnts.dataPtr(), 1, MPI_INT, node_comm) );
+    for (int i = 1; i < NSize; ++i) {
+        disps[i] = disps[i-1] + cnts[i-1];
+    }
+    Array<long> all(disps[NSize-1] + cnts[NSize-1]);
+    BL_MPI_REQUIRE( MPI_Allgatherv(mine.data(), nmine, MPI_LONG,
+                                   all.data(), cnts.dataPtr(), disps.dataPtr(), MPI_LONG,
+                                   node_comm) );
+
+    struct Piece {
+        int node, src, dst;  // node: the other node
+        long nbytes;
+        bool operator< (const Piece& rhs) const {
+            return std::tie(node,src,dst) < std::tie(rhs.node,rhs.src,rhs.dst);
+        }
+    };
+
+    std::vector<Piece> snd_pieces, rcv_pieces;
+    for (int i = 0, N = all.size(); i < N; i += 3)
+    {
+        const int src = all[i], dst = all[i+1];
+        if (ParallelDescriptor::sameNode(src)) {
+            snd_pieces.push_back({ParallelDescriptor::NodeOf(dst), src, dst, all[i+2]});
+        } else {
+            rcv_pieces.push_back({ParallelDescriptor::NodeOf(src), src, dst, all[i+2]});
+        }
+    }
+    std::sort(snd_pieces.begin(), snd_pieces.end());
+    std::sort(rcv_pieces.begin(), rcv_pieces.end());
+
+    m_agg_recv = !rcv_pieces.empty();
+
+    //
+    // Lay out the pieces in the buffers.  The data for (or from) another
+    // node are contiguous and go in one message, sent (or received) by
+    // rank (other node) % (node size) of this node to (or from) rank
+    // (this node) % (other node size) of the other node.
+    //
+    Array<int>         send_rank, recv_rank;
+    Array<std::size_t> send_disp, recv_disp;
+
+    auto layout = [&] (const std::vector<Piece>& pieces, bool sending,
+                       std::size_t& total)
+    {
+        total = 0;
+        for (int i = 0, N = pieces.size(); i < N; )
+        {
+            const int other = pieces[i].node;
+            const std::size_t msg_begin = total;
+
+            for ( ; i < N && pieces[i].node == other; ++i)
+            {
+                const Piece& p = pieces[i];
+                if (sending && p.src == MyProc)
+                {
+                    std::size_t offset = total;
+                    for (const auto& cct : snd_tags.at(p.dst)) {
+                        m_send_tags.push_back(&cct);
+                        m_send_offset.push_back(offset);
+                        offset += cct.sbox.numPts() * bytes_per_cell;
+                    }
+                }
+                else if (!sending && p.dst == MyProc)
+                {
+                    std::size_t offset = total;
+                    for (const auto& cct : rcv_tags.at(p.src)) {
+                        m_recv_tags.push_back(&cct);
+                        m_recv_offset.push_back(offset);
+                        offset += cct.dbox.numPts() * bytes_per_cell;
+                    }
+                }
+                total += p.nbytes;
+            }
+
+            if (ParallelDescriptor::NodeRank(MyNode, other % NSize) == MyProc)
+            {
+                const std::size_t nbytes = total - msg_begin;
+                BL_ASSERT(nbytes < std::numeric_limits<int>::max());
+
+                const int peer = ParallelDescriptor::NodeRank
+                    (other, MyNode % ParallelDescriptor::NodeSize(other));
+                if (sending) {
+                    send_rank.push_back(peer);
+                    send_disp.push_back(msg_begin);
+                    m_send_size.push_back(static_cast<int>(nbytes));
+                } else {
+                    recv_rank.push_back(peer);
+                    recv_disp.push_back(msg_begin);
+                    m_recv_size.push_back(static_cast<int>(nbytes));
+                }
+            }
+        }
+    };
+
+    std::size_t TotalSndsVolume, TotalRcvsVolume;
+    layout(snd_pieces, true , TotalSndsVolume);
+    layout(rcv_pieces, false, TotalRcvsVolume);
+
+    //
+    // One window holds both buffers of the node.
+    //
+    const std::size_t TotalVolume = TotalSndsVolume + TotalRcvsVolume;
+    if (TotalVolume > 0)
+    {
+        char* p;
+        BL_MPI_REQUIRE( MPI_Win_allocate_shared((ParallelDescriptor::MyRankInNode() == 0)
+                                                ? TotalVolume : 0,
+                                                1, MPI_INFO_NULL, node_comm, &p, &m_win) );
+        MPI_Aint sz;
+        int disp_unit;
+        BL_MPI_REQUIRE( MPI_Win_shared_query(m_win, 0, &sz, &disp_unit, &p) );
+        m_the_send_data = p;
+        m_the_recv_data = p + TotalSndsVolume;
+        // for MPI_Win_sync in the node barriers
+        BL_MPI_REQUIRE( MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win) );
+    }
+
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    const int nsend = send_rank.size();
+    m_send_reqs.resize(nsend, MPI_REQUEST_NULL);
+    for (int i = 0; i < nsend; ++i)
+    {
+        BL_MPI_REQUIRE( MPI_Send_init(m_the_send_data+send_disp[i], m_send_size[i], MPI_CHAR,
+                                      send_rank[i], m_tag, comm, &m_send_reqs[i]) );
+    }
+
+    const int nrecv = recv_rank.size();
+    m_recv_reqs.resize(nrecv, MPI_REQUEST_NULL);
+    for (int i = 0; i < nrecv; ++i)
+    {
+        BL_MPI_REQUIRE( MPI_Recv_init(m_the_recv_data+recv_disp[i], m_recv_size[i], MPI_CHAR,
+                                      recv_rank[i], m_tag, comm, &m_recv_reqs[i]) );
+    }
+#endif
+}
+
+FabArrayBase::NodePlan::~NodePlan ()
+{
+    BL_ASSERT(!m_busy);
+#ifdef BL_USE_MPI3
+    for (auto& req : m_send_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+    for (auto& req : m_recv_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+    if (m_win != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(m_win);
+        MPI_Win_free(&m_win);
+    }
+#endif
+    ParallelDescriptor::ReleasePersistentTag(m_tag);
+}
+
+long
+FabArrayBase::NodePlan::bytes () const
+{
+    long cnt = sizeof(FabArrayBase::NodePlan);
+
+    cnt += amrex::bytesOf(m_node_tags)
+        +  amrex::bytesOf(m_send_tags) + amrex::bytesOf(m_send_offset)
+        +  amrex::bytesOf(m_recv_tags) + amrex::bytesOf(m_recv_offset)
+        +  amrex::bytesOf(m_send_size) + amrex::bytesOf(m_recv_size);
+
+    return cnt;
+}
+
+FabArrayBase::NodePlan*
+FabArrayBase::getNodePlan (const void* owner,
+                           const MapOfCopyComTagContainers& snd_tags,
+                           const MapOfCopyComTagContainers& rcv_tags,
+                           bool threadsafe_rcv, int ncomp, int value_size)
+{
+    BL_PROFILE("FabArrayBase::getNodePlan()");
+
+    std::pair<NodePlanCacheIter,NodePlanCacheIter> er_it = m_TheNodePlanCache.equal_range(owner);
+    for (NodePlanCacheIter it = er_it.first; it != er_it.second; ++it)
+    {
+        if (it->second->m_ncomp      == ncomp &&
+            it->second->m_value_size == value_size)
+        {
+            ++(it->second->m_nuse);
+            m_NP_stats.recordUse();
+            return it->second;
+        }
+    }
+
+    // Have to build a new one, unless we have run out of tags.
+    const int tag = ParallelDescriptor::PersistentTag();
+    if (tag < 0) return nullptr;
+
+    NodePlan* new_plan = new NodePlan(owner, snd_tags, rcv_tags, threadsafe_rcv,
+                                      ncomp, value_size, tag);
+    new_plan->m_id = m_NP_stats.nbuild;
+
+#ifdef BL_MEM_PROFILING
+    m_NP_stats.bytes += new_plan->bytes();
+    m_NP_stats.bytes_hwm = std::max(m_NP_stats.bytes_hwm, m_NP_stats.bytes);
+#endif
+
+    new_plan->m_nuse = 1;
+    m_NP_stats.recordBuild();
+    m_NP_stats.recordUse();
+
+    m_TheNodePlanCache.insert(er_it.second, NodePlanCache::value_type(owner,new_plan));
+
+    return new_plan;
+}
+
+void
+FabArrayBase::flushNodePlans (const void* owner)
+{
+    std::pair<NodePlanCacheIter,NodePlanCacheIter> er_it = m_TheNodePlanCache.equal_range(owner);
+    for (NodePlanCacheIter it = er_it.first; it != er_it.second; ++it)
+    {
+#ifdef BL_MEM_PROFILING
+	m_NP_stats.bytes -= it->second->bytes();
+#endif
+	m_NP_stats.recordErase(it->second->m_nuse);
+	delete it->second;
+    }
+    m_TheNodePlanCache.erase(er_it.first, er_it.second);
+}
+
+void
+FabArrayBase::flushNodePlanCache ()
+{
+    std::vector<NodePlan*> plans;
+    for (NodePlanCacheIter it = m_TheNodePlanCache.begin(); it != m_TheNodePlanCache.end(); ++it)
+    {
+        plans.push_back(it->second);
+    }
+    std::sort(plans.begin(), plans.end(),
+              [] (const NodePlan* a, const NodePlan* b) { return a->m_id < b->m_id; });
+    for (NodePlan* plan : plans)
+    {
+	m_NP_stats.recordErase(plan->m_nuse);
+	delete plan;
+    }
+    m_TheNodePlanCache.clear();
+#ifdef BL_MEM_PROFILING
+    m_NP_stats.bytes = 0L;
+#endif
+}
+
 FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
 			      const FabArrayBase& dstfa,
 			      Box                 dstdomain,
@@ -1356,6 +1878,8 @@ FabArrayBase::Finalize ()
 	m_FA_stats.print();
 	m_TAC_stats.print();
 	m_FBC_stats.print();
+	m_FBP_stats.print();
+	m_NP_stats.print();
 	m_CPC_stats.print();
 	m_FPinfo_stats.print();
 	m_CFinfo_stats.print();
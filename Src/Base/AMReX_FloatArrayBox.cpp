@@ -0,0 +1,154 @@
+
+#include <AMReX_FloatArrayBox.H>
+#include <AMReX_BLassert.H>
+
+namespace amrex {
+
+namespace
+{
+    //
+    // Lower corner and extents of a box, padded to three dimensions.
+    //
+    struct Box3
+    {
+        explicit Box3 (const Box& b)
+        {
+            for (int d = 0; d < 3; ++d) {
+                lo[d]  = (d < BL_SPACEDIM) ? b.smallEnd(d) : 0;
+                len[d] = (d < BL_SPACEDIM) ? b.length(d)   : 1;
+            }
+        }
+        long offset (int i, int j, int k) const
+        {
+            return (i-lo[0]) + long(len[0])*((j-lo[1]) + long(len[1])*(k-lo[2]));
+        }
+        long npts () const { return long(len[0])*len[1]*len[2]; }
+        int lo[3];
+        int len[3];
+    };
+
+    //
+    // Apply f(dst_value, src_value) over destbox of dst and the
+    // same-sized srcbox of src, one x-pencil at a time.
+    //
+    template <class D, class S, class F>
+    void
+    pairLoop (BaseFab<D>& dst, const Box& destbox, int destcomp,
+              const BaseFab<S>& src, const Box& srcbox, int srccomp,
+              int numcomp, F&& f)
+    {
+        BL_ASSERT(destbox.sameSize(srcbox));
+        BL_ASSERT(dst.box().contains(destbox) && src.box().contains(srcbox));
+        BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= dst.nComp());
+        BL_ASSERT(srccomp  >= 0 && srccomp +numcomp <= src.nComp());
+
+        if (!destbox.ok()) return;
+
+        const Box3 db(dst.box()), sb(src.box()), bx(destbox), sx(srcbox);
+
+        for (int n = 0; n < numcomp; ++n)
+        {
+            D*       dp = dst.dataPtr(destcomp+n);
+            const S* sp = src.dataPtr(srccomp+n);
+
+            for (int k = 0; k < bx.len[2]; ++k) {
+                for (int j = 0; j < bx.len[1]; ++j) {
+                    D*       d = dp + db.offset(bx.lo[0], bx.lo[1]+j, bx.lo[2]+k);
+                    const S* s = sp + sb.offset(sx.lo[0], sx.lo[1]+j, sx.lo[2]+k);
+                    for (int i = 0; i < bx.len[0]; ++i) {
+                        f(d[i], s[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+FloatArrayBox::FloatArrayBox () {}
+
+FloatArrayBox::FloatArrayBox (const Box& b,
+                              int        n,
+                              bool       alloc,
+                              bool       shared)
+    :
+    BaseFab<float>(b,n,alloc,shared)
+{
+}
+
+FloatArrayBox::FloatArrayBox (const FloatArrayBox& rhs, MakeType make_type, int scomp, int ncomp)
+    :
+    BaseFab<float>(rhs,make_type,scomp,ncomp)
+{
+}
+
+FloatArrayBox&
+FloatArrayBox::operator= (const float& r)
+{
+    BaseFab<float>::operator=(r);
+    return *this;
+}
+
+FloatArrayBox&
+FloatArrayBox::copy (const FArrayBox& src,
+                     const Box&       srcbox,
+                     int              srccomp,
+                     const Box&       destbox,
+                     int              destcomp,
+                     int              numcomp)
+{
+    pairLoop(*this, destbox, destcomp, src, srcbox, srccomp, numcomp,
+             [] (float& d, const Real& s) { d = static_cast<float>(s); });
+    return *this;
+}
+
+void
+FloatArrayBox::copyTo (FArrayBox& dst,
+                       const Box& srcbox,
+                       int        srccomp,
+                       const Box& destbox,
+                       int        destcomp,
+                       int        numcomp) const
+{
+    pairLoop(dst, destbox, destcomp, *this, srcbox, srccomp, numcomp,
+             [] (Real& d, const float& s) { d = s; });
+}
+
+FloatArrayBox&
+FloatArrayBox::saxpy (Real                 a,
+                      const FloatArrayBox& x,
+                      const Box&           srcbox,
+                      const Box&           destbox,
+                      int                  srccomp,
+                      int                  destcomp,
+                      int                  numcomp)
+{
+    pairLoop(*this, destbox, destcomp, x, srcbox, srccomp, numcomp,
+             [a] (float& d, const float& s) { d = static_cast<float>(Real(d) + a*Real(s)); });
+    return *this;
+}
+
+Real
+FloatArrayBox::dot (const Box&           xbx,
+                    int                  xcomp,
+                    const FloatArrayBox& y,
+                    const Box&           ybx,
+                    int                  ycomp,
+                    int                  numcomp) const
+{
+    Real r = 0;
+    //
+    // pairLoop wants a writable first argument; nothing is written here.
+    //
+    FloatArrayBox& self = const_cast<FloatArrayBox&>(*this);
+    pairLoop(self, xbx, xcomp, y, ybx, ycomp, numcomp,
+             [&r] (const float& a, const float& b) { r += Real(a)*Real(b); });
+    return r;
+}
+
+Real
+FloatArrayBox::sumsq (const Box& subbox, int comp, int numcomp) const
+{
+    return dot(subbox, comp, *this, subbox, comp, numcomp);
+}
+
+}
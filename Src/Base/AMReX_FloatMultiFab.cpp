@@ -0,0 +1,208 @@
+
+#include <cmath>
+
+#include <AMReX_BLassert.H>
+#include <AMReX_FloatMultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BLProfiler.H>
+
+namespace amrex {
+
+FloatMultiFab::FloatMultiFab () {}
+
+FloatMultiFab::FloatMultiFab (const BoxArray&            bxs,
+                              const DistributionMapping& dm,
+                              int                        ncomp,
+                              int                        ngrow,
+                              const MFInfo&              info)
+    :
+    FabArray<FloatArrayBox>(bxs,dm,ncomp,ngrow,info)
+{
+}
+
+FloatMultiFab::FloatMultiFab (const FloatMultiFab& rhs, MakeType maketype, int scomp, int ncomp)
+    :
+    FabArray<FloatArrayBox>(rhs, maketype, scomp, ncomp)
+{
+}
+
+void
+FloatMultiFab::operator= (const float& r)
+{
+    setVal(r);
+}
+
+Real
+FloatMultiFab::norm2 (int comp) const
+{
+    BL_ASSERT(ixType().cellCentered());
+
+    Real nm2 = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nm2)
+#endif
+    for (MFIter mfi(*this,true); mfi.isValid(); ++mfi)
+    {
+        nm2 += get(mfi).sumsq(mfi.tilebox(), comp, 1);
+    }
+
+    ParallelDescriptor::ReduceRealSum(nm2, color());
+
+    return std::sqrt(nm2);
+}
+
+void
+FloatMultiFab::Copy (FloatMultiFab&  dst,
+                     const MultiFab& src,
+                     int             srccomp,
+                     int             dstcomp,
+                     int             numcomp,
+                     int             nghost)
+{
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+    BL_ASSERT(dst.DistributionMap() == src.DistributionMap());
+    BL_ASSERT(dst.nGrow() >= nghost && src.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            dst[mfi].copy(src[mfi], bx, srccomp, bx, dstcomp, numcomp);
+    }
+}
+
+void
+FloatMultiFab::Copy (MultiFab&            dst,
+                     const FloatMultiFab& src,
+                     int                  srccomp,
+                     int                  dstcomp,
+                     int                  numcomp,
+                     int                  nghost)
+{
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+    BL_ASSERT(dst.DistributionMap() == src.DistributionMap());
+    BL_ASSERT(dst.nGrow() >= nghost && src.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            src[mfi].copyTo(dst[mfi], bx, srccomp, bx, dstcomp, numcomp);
+    }
+}
+
+void
+FloatMultiFab::Add (FloatMultiFab&       dst,
+                    const FloatMultiFab& src,
+                    int                  srccomp,
+                    int                  dstcomp,
+                    int                  numcomp,
+                    int                  nghost)
+{
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+    BL_ASSERT(dst.distributionMap == src.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && src.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            dst[mfi].plus(src[mfi], bx, bx, srccomp, dstcomp, numcomp);
+    }
+}
+
+void
+FloatMultiFab::Saxpy (FloatMultiFab&       dst,
+                      Real                 a,
+                      const FloatMultiFab& src,
+                      int                  srccomp,
+                      int                  dstcomp,
+                      int                  numcomp,
+                      int                  nghost)
+{
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+    BL_ASSERT(dst.distributionMap == src.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && src.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            dst[mfi].saxpy(a, src[mfi], bx, bx, srccomp, dstcomp, numcomp);
+    }
+}
+
+void
+FloatMultiFab::LinComb (FloatMultiFab&       dst,
+                        Real                 a,
+                        const FloatMultiFab& x,
+                        int                  xcomp,
+                        Real                 b,
+                        const FloatMultiFab& y,
+                        int                  ycomp,
+                        int                  dstcomp,
+                        int                  numcomp,
+                        int                  nghost)
+{
+    BL_ASSERT(dst.boxArray() == x.boxArray());
+    BL_ASSERT(dst.distributionMap == x.distributionMap);
+    BL_ASSERT(dst.boxArray() == y.boxArray());
+    BL_ASSERT(dst.distributionMap == y.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && x.nGrow() >= nghost && y.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            dst[mfi].linComb(x[mfi],bx,xcomp,y[mfi],bx,ycomp,a,b,bx,dstcomp,numcomp);
+    }
+}
+
+Real
+FloatMultiFab::Dot (const FloatMultiFab& x, int xcomp,
+                    const FloatMultiFab& y, int ycomp,
+                    int numcomp, int nghost, bool local)
+{
+    BL_ASSERT(x.boxArray() == y.boxArray());
+    BL_ASSERT(x.DistributionMap() == y.DistributionMap());
+    BL_ASSERT(x.nGrow() >= nghost && y.nGrow() >= nghost);
+
+    Real sm = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:sm)
+#endif
+    for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+        sm += x[mfi].dot(bx,xcomp,y[mfi],bx,ycomp,numcomp);
+    }
+
+    if (!local)
+        ParallelDescriptor::ReduceRealSum(sm, x.color());
+
+    return sm;
+}
+
+}
@@ -107,6 +107,64 @@ MFIter::~MFIter ()
 #endif
 }
 
+namespace {
+    //
+    // Split [ibegin,iend) among team workers and then among OpenMP threads.
+    //
+    void
+    splitRange (int ibegin, int iend, bool shared_tiles, int& b, int& e)
+    {
+	int rit = 0;
+	int nworkers = 1;
+#ifdef BL_USE_TEAM
+	if (ParallelDescriptor::TeamSize() > 1 && shared_tiles) {
+	    rit = ParallelDescriptor::MyRankInTeam();
+	    nworkers = ParallelDescriptor::TeamSize();
+	}
+#else
+	(void) shared_tiles;
+#endif
+
+	int ntot = iend - ibegin;
+	    
+	if (nworkers == 1)
+	{
+	    b = ibegin;
+	    e = iend;
+	}
+	else
+	{
+	    int nr   = ntot / nworkers;
+	    int nlft = ntot - nr * nworkers;
+	    if (rit < nlft) {  // get nr+1 items
+		b = ibegin + rit * (nr + 1);
+		e = b + nr + 1;
+	    } else {           // get nr items
+		b = ibegin + rit * nr + nlft;
+		e = b + nr;
+	    }
+	}
+	
+#ifdef _OPENMP
+	int nthreads = omp_get_num_threads();
+	if (nthreads > 1)
+	{
+	    int tid = omp_get_thread_num();
+	    ntot = e - b;
+	    int nr   = ntot / nthreads;
+	    int nlft = ntot - nr * nthreads;
+	    if (tid < nlft) {  // get nr+1 items
+		b += tid * (nr + 1);
+		e = b + nr + 1;
+	    } else {           // get nr items
+		b += tid * nr + nlft;
+		e = b + nr;
+	    }	    
+	}
+#endif
+    }
+}
+
 void 
 MFIter::Initialize ()
 {
@@ -123,75 +181,85 @@ MFIter::Initialize ()
     else
     {
 	const FabArrayBase::TileArray* pta = fabArray.getTileArray(tile_size);
-	
-	index_map            = &(pta->indexMap);
-	local_index_map      = &(pta->localIndexMap);
-	tile_array           = &(pta->tileArray);
-	local_tile_index_map = &(pta->localTileIndexMap);
-	num_local_tiles      = &(pta->numLocalTiles);
 
+	int ntot = pta->indexMap.size();
+	int nint = ntot;
+
+	if (flags & InteriorFirst)
 	{
-	    int rit = 0;
-	    int nworkers = 1;
-#ifdef BL_USE_TEAM
-	    if (ParallelDescriptor::TeamSize() > 1) {
-		if ( tile_size == IntVect::TheZeroVector() ) {
-		    // In this case the TileArray contains only boxes owned by this worker.
-		    // So there is no sharing going on.
-		    rit = 0;
-		    nworkers = 1;
+	    // Tiles independent of ghost cells go first.
+	    const BoxArray& ba = fabArray.boxArray();
+	    Array<int> order, halo_tiles;
+	    order.reserve(ntot);
+	    for (int i = 0; i < ntot; ++i)
+	    {
+		const Box& vbx = ba.getCellCenteredBox(pta->indexMap[i]);
+		if (vbx.contains(amrex::grow(pta->tileArray[i], halo_width))) {
+		    order.push_back(i);
 		} else {
-		    rit = ParallelDescriptor::MyRankInTeam();
-		    nworkers = ParallelDescriptor::TeamSize();
+		    halo_tiles.push_back(i);
 		}
 	    }
-#endif
-
-	    int ntot = index_map->size();
-	    
-	    if (nworkers == 1)
+	    nint = order.size();
+	    order.insert(order.end(), halo_tiles.begin(), halo_tiles.end());
+
+	    m_lta.reset(new FabArrayBase::TileArray);
+	    m_lta->indexMap.reserve(ntot);
+	    m_lta->localIndexMap.reserve(ntot);
+	    m_lta->localTileIndexMap.reserve(ntot);
+	    m_lta->numLocalTiles.reserve(ntot);
+	    m_lta->tileArray.reserve(ntot);
+	    for (int i : order)
 	    {
-		beginIndex = 0;
-		endIndex = ntot;
-	    }
-	    else
-	    {
-		int nr   = ntot / nworkers;
-		int nlft = ntot - nr * nworkers;
-		if (rit < nlft) {  // get nr+1 items
-		    beginIndex = rit * (nr + 1);
-		    endIndex = beginIndex + nr + 1;
-		} else {           // get nr items
-		    beginIndex = rit * nr + nlft;
-		    endIndex = beginIndex + nr;
-		}
+		m_lta->indexMap.push_back(pta->indexMap[i]);
+		m_lta->localIndexMap.push_back(pta->localIndexMap[i]);
+		m_lta->localTileIndexMap.push_back(pta->localTileIndexMap[i]);
+		m_lta->numLocalTiles.push_back(pta->numLocalTiles[i]);
+		m_lta->tileArray.push_back(pta->tileArray[i]);
 	    }
+	    pta = m_lta.get();
 	}
 	
-#ifdef _OPENMP
-	int nthreads = omp_get_num_threads();
-	if (nthreads > 1)
-	{
-	    int tid = omp_get_thread_num();
-	    int ntot = endIndex - beginIndex;
-	    int nr   = ntot / nthreads;
-	    int nlft = ntot - nr * nthreads;
-	    if (tid < nlft) {  // get nr+1 items
-		beginIndex += tid * (nr + 1);
-		endIndex = beginIndex + nr + 1;
-	    } else {           // get nr items
-		beginIndex += tid * nr + nlft;
-		endIndex = beginIndex + nr;
-	    }	    
+	index_map            = &(pta->indexMap);
+	local_index_map      = &(pta->localIndexMap);
+	tile_array           = &(pta->tileArray);
+	local_tile_index_map = &(pta->localTileIndexMap);
+	num_local_tiles      = &(pta->numLocalTiles);
+
+	// In the untiled case, the TileArray contains only boxes owned by
+	// this team worker.  So there is no sharing going on.
+	const bool shared_tiles = tile_size != IntVect::TheZeroVector();
+
+	splitRange(0, nint, shared_tiles, beginIndex, endIndex);
+
+	if (flags & InteriorFirst) {
+	    splitRange(nint, ntot, shared_tiles, haloBeginIndex, haloEndIndex);
 	}
-#endif
 
 	currentIndex = beginIndex;
 
 	typ = fabArray.boxArray().ixType();
+
+	if (halo_pending && currentIndex == endIndex) HaloPhase();
     }
 }
 
+void
+MFIter::HaloPhase ()
+{
+    halo_pending = false;
+
+    // All threads must get here exactly once.  The implicit barrier at the
+    // end of single makes sure no one touches ghost cells too early.
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    halo_finish();
+
+    currentIndex = beginIndex = haloBeginIndex;
+    endIndex = haloEndIndex;
+}
+
 Box 
 MFIter::tilebox () const
 { 
@@ -298,6 +366,26 @@ MFIter::grownnodaltilebox (int dir, int ng) const
     return bx;
 }
 
+MFCostTimer::MFCostTimer (const MFIter& mfi, FabArray<FArrayBox>& cost)
+    :
+    m_mfi(mfi),
+    m_cost(cost),
+    m_t0(ParallelDescriptor::second())
+{
+    BL_ASSERT(cost.size() == 0 || cost.nComp() == 1);
+    BL_ASSERT(cost.size() == 0 || cost.boxArray().ixType().cellCentered());
+    BL_ASSERT(cost.size() == 0 || cost.DistributionMap() == mfi.DistributionMap());
+}
+
+MFCostTimer::~MFCostTimer ()
+{
+    if (m_cost.size() == 0) return;
+
+    const double dt = ParallelDescriptor::second() - m_t0;
+    const Box& bx = m_mfi.tilebox(IntVect::TheZeroVector());
+    m_cost[m_mfi].plus(Real(dt/bx.numPts()), bx, 0, 1);
+}
+
 MFGhostIter::MFGhostIter (const FabArrayBase& fabarray)
     :
     MFIter(fabarray, (unsigned char)(SkipInit|Tiling))
@@ -283,6 +283,172 @@ MultiFab::AddProduct (MultiFab&       dst,
     }
 }
 
+void
+MultiFab::LinComb (MultiFab&       dst,
+		   Real            a,
+		   const MultiFab& x,
+		   int             xcomp,
+		   Real            b,
+		   const MultiFab& y,
+		   int             ycomp,
+		   Real            c,
+		   const MultiFab& z,
+		   int             zcomp,
+		   int             dstcomp,
+		   int             numcomp,
+		   int             nghost)
+{
+    BL_ASSERT(dst.boxArray() == x.boxArray());
+    BL_ASSERT(dst.distributionMap == x.distributionMap);
+    BL_ASSERT(dst.boxArray() == y.boxArray());
+    BL_ASSERT(dst.distributionMap == y.distributionMap);
+    BL_ASSERT(dst.boxArray() == z.boxArray());
+    BL_ASSERT(dst.distributionMap == z.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && x.nGrow() >= nghost && y.nGrow() >= nghost && z.nGrow() >= nghost);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            fort_fab_lincomb3(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                              BL_TO_FORTRAN_N_3D(dst[mfi],dstcomp),
+                              &a, BL_TO_FORTRAN_N_3D(x[mfi],xcomp), ARLIM_3D(bx.loVect()),
+                              &b, BL_TO_FORTRAN_N_3D(y[mfi],ycomp), ARLIM_3D(bx.loVect()),
+                              &c, BL_TO_FORTRAN_N_3D(z[mfi],zcomp), ARLIM_3D(bx.loVect()),
+                              &numcomp);
+    }
+}
+
+Real
+MultiFab::SaxpyNorm0 (MultiFab&       dst,
+		      Real            a,
+		      const MultiFab& src,
+		      int             srccomp,
+		      int             dstcomp,
+		      int             numcomp,
+		      int             nghost,
+		      bool            local)
+{
+    BL_ASSERT(dst.boxArray() == src.boxArray());
+    BL_ASSERT(dst.distributionMap == src.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && src.nGrow() >= nghost);
+
+    Real nm0 = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(max:nm0)
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            nm0 = std::max(nm0,
+                           fort_fab_saxpy_norm0(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                                BL_TO_FORTRAN_N_3D(dst[mfi],dstcomp),
+                                                &a,
+                                                BL_TO_FORTRAN_N_3D(src[mfi],srccomp), ARLIM_3D(bx.loVect()),
+                                                &numcomp));
+    }
+
+    if (!local)
+        ParallelDescriptor::ReduceRealMax(nm0, dst.color());
+
+    return nm0;
+}
+
+Real
+MultiFab::LinCombNorm0 (MultiFab&       dst,
+			Real            a,
+			const MultiFab& x,
+			int             xcomp,
+			Real            b,
+			const MultiFab& y,
+			int             ycomp,
+			int             dstcomp,
+			int             numcomp,
+			int             nghost,
+			bool            local)
+{
+    BL_ASSERT(dst.boxArray() == x.boxArray());
+    BL_ASSERT(dst.distributionMap == x.distributionMap);
+    BL_ASSERT(dst.boxArray() == y.boxArray());
+    BL_ASSERT(dst.distributionMap == y.distributionMap);
+    BL_ASSERT(dst.nGrow() >= nghost && x.nGrow() >= nghost && y.nGrow() >= nghost);
+
+    Real nm0 = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(max:nm0)
+#endif
+    for (MFIter mfi(dst,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+            nm0 = std::max(nm0,
+                           fort_fab_lincomb_norm0(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                                  BL_TO_FORTRAN_N_3D(dst[mfi],dstcomp),
+                                                  &a, BL_TO_FORTRAN_N_3D(x[mfi],xcomp), ARLIM_3D(bx.loVect()),
+                                                  &b, BL_TO_FORTRAN_N_3D(y[mfi],ycomp), ARLIM_3D(bx.loVect()),
+                                                  &numcomp));
+    }
+
+    if (!local)
+        ParallelDescriptor::ReduceRealMax(nm0, dst.color());
+
+    return nm0;
+}
+
+void
+MultiFab::Dot2 (const MultiFab& x, int xcomp,
+		const MultiFab& y, int ycomp,
+		const MultiFab& z, int zcomp,
+		int numcomp, int nghost,
+		Real& xy, Real& xz,
+		bool local)
+{
+    BL_ASSERT(x.boxArray() == y.boxArray());
+    BL_ASSERT(x.DistributionMap() == y.DistributionMap());
+    BL_ASSERT(x.boxArray() == z.boxArray());
+    BL_ASSERT(x.DistributionMap() == z.DistributionMap());
+    BL_ASSERT(x.nGrow() >= nghost && y.nGrow() >= nghost && z.nGrow() >= nghost);
+
+    Real sxy = 0.0, sxz = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:sxy,sxz)
+#endif
+    for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox(nghost);
+
+        if (bx.ok())
+        {
+            Real dp[2];
+            fort_fab_dot2(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                          BL_TO_FORTRAN_N_3D(x[mfi],xcomp),
+                          BL_TO_FORTRAN_N_3D(y[mfi],ycomp), ARLIM_3D(bx.loVect()),
+                          BL_TO_FORTRAN_N_3D(z[mfi],zcomp), ARLIM_3D(bx.loVect()),
+                          &numcomp, dp);
+            sxy += dp[0];
+            sxz += dp[1];
+        }
+    }
+
+    Real vals[2] = { sxy, sxz };
+
+    if (!local)
+        ParallelDescriptor::ReduceRealSum(vals, 2, x.color());
+
+    xy = vals[0];
+    xz = vals[1];
+}
+
 void
 MultiFab::plus (Real val,
                 int  nghost)
@@ -81,6 +81,10 @@ namespace ParallelDescriptor
     //
     ProcessTeam m_Team;
     //
+    // Node
+    //
+    ProcessNode m_Node;
+    //
     // AMReX's Communicators
     //
     MPI_Comm m_comm_all     = MPI_COMM_NULL;    // for all ranks, probably MPI_COMM_WORLD
@@ -112,6 +116,7 @@ namespace ParallelDescriptor
     int inWhichSidecar = notInSidecar;
     //
     ProcessTeam m_Team;
+    ProcessNode m_Node;
     //
     MPI_Comm m_comm_all     = 0;
     MPI_Comm m_comm_comp    = 0;
@@ -131,6 +136,12 @@ namespace ParallelDescriptor
     Color m_MyCommCompColor;
 
     int m_MinTag = 1000, m_MaxTag = -1, m_MaxTag_MPI = -1, tagBuffer = 32;
+    //
+    // Tags [m_MinTag-nPersistentTags, m_MinTag) are for PersistentTag().
+    // A tag is in use until it is given back by ReleasePersistentTag().
+    //
+    const int nPersistentTags = 512;
+    std::vector<char> persistent_tag_used(nPersistentTags, 0);
 
     const int ioProcessor = 0;
 
@@ -740,9 +751,11 @@ ParallelDescriptor::SetNProcsSidecars (const Array<int> &compRanksInAll,
 #endif
 
     ParallelDescriptor::EndTeams();
+    ParallelDescriptor::EndNodes();
     ParallelDescriptor::EndSubCommunicator();
 
     ParallelDescriptor::StartTeams();
+    ParallelDescriptor::StartNodes();
     ParallelDescriptor::StartSubCommunicator();
 
 
@@ -2440,6 +2453,31 @@ ParallelDescriptor::SubSeqNum (int getsetinc, int newvalue)
     return result;
 }
 
+int
+ParallelDescriptor::PersistentTag ()
+{
+    //
+    // The lowest free tag, so that processes that have taken and given
+    // back the same tags agree on it whatever the order of the releases.
+    //
+    for (int i = 0; i < nPersistentTags; ++i) {
+        if (!persistent_tag_used[i]) {
+            persistent_tag_used[i] = 1;
+            return m_MinTag - nPersistentTags + i;
+        }
+    }
+    return -1;
+}
+
+void
+ParallelDescriptor::ReleasePersistentTag (int tag)
+{
+    if (tag < 0) return;
+    const int i = tag - (m_MinTag - nPersistentTags);
+    BL_ASSERT(i >= 0 && i < nPersistentTags && persistent_tag_used[i]);
+    persistent_tag_used[i] = 0;
+}
+
 
 BL_FORT_PROC_DECL(BL_PD_BARRIER,bl_pd_barrier)()
 {
@@ -2716,6 +2754,104 @@ ParallelDescriptor::EndTeams ()
     m_Team.clear();
 }
 
+#ifndef BL_AMRPROF
+void
+ParallelDescriptor::StartNodes ()
+{
+    // StartNodes may be called again after ParmParse is initialized.
+    EndNodes();
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int rank   = ParallelDescriptor::MyProc();
+
+    //
+    // Each node is identified by its lowest rank.  Without MPI-3 shared
+    // memory every rank is a node of its own.
+    //
+    Array<int> leads(nprocs);
+    for (int r = 0; r < nprocs; ++r) {
+	leads[r] = r;
+    }
+
+#ifdef BL_USE_MPI3
+    {
+	int max_size = 0;
+	ParmParse pp("node");
+	pp.query("max_size", max_size);
+
+	MPI_Comm shared_comm;
+	BL_MPI_REQUIRE( MPI_Comm_split_type(ParallelDescriptor::Communicator(),
+					    MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+					    &shared_comm) );
+	int rank_in_shared;
+	BL_MPI_REQUIRE( MPI_Comm_rank(shared_comm, &rank_in_shared) );
+
+	const int color = (max_size > 0) ? rank_in_shared / max_size : 0;
+	BL_MPI_REQUIRE( MPI_Comm_split(shared_comm, color, rank, &m_Node.m_node_comm) );
+	BL_MPI_REQUIRE( MPI_Comm_free(&shared_comm) );
+
+	BL_MPI_REQUIRE( MPI_Comm_size(m_Node.m_node_comm, &m_Node.m_size) );
+	BL_MPI_REQUIRE( MPI_Comm_rank(m_Node.m_node_comm, &m_Node.m_rankInNode) );
+
+	int lead = rank;
+	BL_MPI_REQUIRE( MPI_Bcast(&lead, 1, MPI_INT, 0, m_Node.m_node_comm) );
+	BL_MPI_REQUIRE( MPI_Allgather(&lead, 1, MPI_INT, leads.dataPtr(), 1, MPI_INT,
+				      ParallelDescriptor::Communicator()) );
+    }
+#endif
+
+    m_Node.m_numNodes = 0;
+    m_Node.m_node_of.resize(nprocs);
+    Array<int> cnt;
+    for (int r = 0; r < nprocs; ++r) {
+	if (leads[r] == r) {
+	    m_Node.m_node_of[r] = m_Node.m_numNodes++;
+	    cnt.push_back(0);
+	} else {
+	    m_Node.m_node_of[r] = m_Node.m_node_of[leads[r]];
+	}
+	++cnt[m_Node.m_node_of[r]];
+    }
+
+    m_Node.m_first.resize(m_Node.m_numNodes+1);
+    m_Node.m_first[0] = 0;
+    for (int i = 0; i < m_Node.m_numNodes; ++i) {
+	m_Node.m_first[i+1] = m_Node.m_first[i] + cnt[i];
+    }
+
+    m_Node.m_ranks.resize(nprocs);
+    for (int r = 0; r < nprocs; ++r) {
+	const int node = m_Node.m_node_of[r];
+	m_Node.m_ranks[m_Node.m_first[node+1] - cnt[node]--] = r;
+    }
+
+    m_Node.m_node = m_Node.m_node_of[rank];
+}
+#endif
+
+void
+ParallelDescriptor::EndNodes ()
+{
+    m_Node.clear();
+}
+
+void
+ParallelDescriptor::ProcessNode::clear ()
+{
+#ifdef BL_USE_MPI3
+    if (m_node_comm != MPI_COMM_NULL) {
+	BL_MPI_REQUIRE( MPI_Comm_free(&m_node_comm) );
+    }
+#endif
+    m_numNodes   = 1;
+    m_size       = 1;
+    m_node       = 0;
+    m_rankInNode = 0;
+    m_node_of.clear();
+    m_first.clear();
+    m_ranks.clear();
+}
+
 
 bool
 ParallelDescriptor::MPIOneSided ()
@@ -0,0 +1,321 @@
+
+#include <cmath>
+#include <algorithm>
+
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_ReduceBatch.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_BLProfiler.H>
+
+namespace amrex {
+
+namespace
+{
+    bool initialized = false;
+#ifdef BL_USE_MPI
+    //
+    // The reduction buffer holds (value, op) pairs so that sums, maxima
+    // and minima can share one reduction with a user defined op.
+    //
+    MPI_Datatype pair_type = MPI_DATATYPE_NULL;
+    MPI_Op       batch_op  = MPI_OP_NULL;
+
+    void
+    batch_reduce (void* invec, void* inoutvec, int* len, MPI_Datatype*)
+    {
+        const Real* in    = static_cast<const Real*>(invec);
+        Real*       inout = static_cast<Real*>(inoutvec);
+
+        for (int i = 0, N = *len; i < N; ++i)
+        {
+            const Real v = in[2*i];
+            Real&      r = inout[2*i];
+
+            switch (static_cast<int>(inout[2*i+1]))
+            {
+            case ReduceBatch::Sum: r += v;              break;
+            case ReduceBatch::Max: r  = std::max(r, v); break;
+            case ReduceBatch::Min: r  = std::min(r, v); break;
+            }
+        }
+    }
+#endif
+}
+
+struct ReduceBatch::State
+    :
+    public std::enable_shared_from_this<ReduceBatch::State>
+{
+    explicit State (ParallelDescriptor::Color c)
+        : color(c), req(MPI_REQUEST_NULL), posted(false), done(false) {}
+
+    void post ();
+    bool test ();
+    void wait ();
+
+    ParallelDescriptor::Color color;
+    std::vector<Real>         buf;  // (value, op) pairs
+    MPI_Request               req;
+    bool                      posted;
+    bool                      done;
+
+    static std::vector<std::shared_ptr<State> > outstanding;
+};
+
+std::vector<std::shared_ptr<ReduceBatch::State> > ReduceBatch::State::outstanding;
+
+void
+ReduceBatch::State::post ()
+{
+    BL_ASSERT(!posted);
+
+    posted = true;
+
+#ifdef BL_USE_MPI
+    if (!buf.empty() && ParallelDescriptor::isActive(color) &&
+        ParallelDescriptor::NProcs(color) > 1)
+    {
+        BL_PROFILE("ReduceBatch::post()");
+
+#ifdef BL_USE_MPI3
+        BL_MPI_REQUIRE( MPI_Iallreduce(MPI_IN_PLACE, buf.data(), buf.size()/2,
+                                       pair_type, batch_op,
+                                       ParallelDescriptor::Communicator(color), &req) );
+        //
+        // Like Lazy::QueueReduction, keep the request around so that it is
+        // completed at Finalize() even if nobody waits on it.
+        //
+        outstanding.erase(std::remove_if(outstanding.begin(), outstanding.end(),
+                                         [] (const std::shared_ptr<State>& st)
+                                         { return st->test(); }),
+                          outstanding.end());
+        outstanding.push_back(shared_from_this());
+        return;
+#else
+        //
+        // No MPI_Iallreduce before MPI-3, so the batch is reduced now.
+        //
+        BL_MPI_REQUIRE( MPI_Allreduce(MPI_IN_PLACE, buf.data(), buf.size()/2,
+                                      pair_type, batch_op,
+                                      ParallelDescriptor::Communicator(color)) );
+#endif
+    }
+#endif
+
+    done = true;
+}
+
+bool
+ReduceBatch::State::test ()
+{
+    if (!posted) return false;
+
+#ifdef BL_USE_MPI
+    if (!done)
+    {
+        int flag;
+        BL_MPI_REQUIRE( MPI_Test(&req, &flag, MPI_STATUS_IGNORE) );
+        done = flag;
+    }
+#endif
+
+    return done;
+}
+
+void
+ReduceBatch::State::wait ()
+{
+    if (!posted) post();
+
+#ifdef BL_USE_MPI
+    if (!done)
+    {
+        BL_PROFILE("ReduceBatch::wait()");
+        BL_MPI_REQUIRE( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+        done = true;
+    }
+#endif
+}
+
+bool
+ReduceBatch::Future::ready () const
+{
+    BL_ASSERT(state);
+    return state->test();
+}
+
+Real
+ReduceBatch::Future::get () const
+{
+    BL_ASSERT(state);
+    state->wait();
+    const Real r = state->buf[2*idx];
+    return sqrt_result ? std::sqrt(r) : r;
+}
+
+void
+ReduceBatch::Initialize ()
+{
+    if (initialized) return;
+
+#ifdef BL_USE_MPI
+    BL_MPI_REQUIRE( MPI_Type_contiguous(2, ParallelDescriptor::Mpi_typemap<Real>::type(), &pair_type) );
+    BL_MPI_REQUIRE( MPI_Type_commit(&pair_type) );
+    BL_MPI_REQUIRE( MPI_Op_create(batch_reduce, 1, &batch_op) );
+#endif
+
+    amrex::ExecOnFinalize(ReduceBatch::Finalize);
+
+    initialized = true;
+}
+
+void
+ReduceBatch::Finalize ()
+{
+#ifdef BL_USE_MPI
+    //
+    // Complete any outstanding requests before freeing the op.
+    //
+    for (auto& st : State::outstanding) {
+        st->wait();
+    }
+    State::outstanding.clear();
+
+    if (batch_op != MPI_OP_NULL) {
+        BL_MPI_REQUIRE( MPI_Op_free(&batch_op) );
+    }
+    if (pair_type != MPI_DATATYPE_NULL) {
+        BL_MPI_REQUIRE( MPI_Type_free(&pair_type) );
+    }
+#endif
+
+    initialized = false;
+}
+
+ReduceBatch::ReduceBatch (ParallelDescriptor::Color color)
+    :
+    m_color(color)
+{
+    if (!initialized) {
+        ReduceBatch::Initialize();
+    }
+}
+
+ReduceBatch::~ReduceBatch ()
+{
+    if (numPending() > 0) {
+        post();
+    }
+}
+
+int
+ReduceBatch::numPending () const
+{
+    if (m_states.empty() || m_states.back()->posted) return 0;
+    return m_states.back()->buf.size()/2;
+}
+
+ReduceBatch::Future
+ReduceBatch::add (Real local_value, ReduceOp op)
+{
+    if (m_states.empty() || m_states.back()->posted) {
+        m_states.push_back(std::make_shared<State>(m_color));
+    }
+
+    std::shared_ptr<State>& st = m_states.back();
+
+    const int idx = st->buf.size()/2;
+
+    st->buf.push_back(local_value);
+    st->buf.push_back(static_cast<Real>(op));
+
+    return Future(st, idx, false);
+}
+
+ReduceBatch::Future
+ReduceBatch::norm0 (const MultiFab& mf, int comp, int nghost)
+{
+    BL_ASSERT(mf.color() == m_color);
+    return add(mf.norm0(comp,nghost,true), Max);
+}
+
+ReduceBatch::Future
+ReduceBatch::norm1 (const MultiFab& mf, int comp, int ngrow)
+{
+    BL_ASSERT(mf.color() == m_color);
+    return add(mf.norm1(comp,ngrow,true), Sum);
+}
+
+ReduceBatch::Future
+ReduceBatch::norm2 (const MultiFab& mf, int comp)
+{
+    BL_ASSERT(mf.color() == m_color);
+    Future f = add(MultiFab::Dot(mf,comp,mf,comp,1,0,true), Sum);
+    f.sqrt_result = true;
+    return f;
+}
+
+ReduceBatch::Future
+ReduceBatch::sum (const MultiFab& mf, int comp)
+{
+    BL_ASSERT(mf.color() == m_color);
+    return add(mf.sum(comp,true), Sum);
+}
+
+ReduceBatch::Future
+ReduceBatch::min (const MultiFab& mf, int comp, int nghost)
+{
+    BL_ASSERT(mf.color() == m_color);
+    return add(mf.min(comp,nghost,true), Min);
+}
+
+ReduceBatch::Future
+ReduceBatch::max (const MultiFab& mf, int comp, int nghost)
+{
+    BL_ASSERT(mf.color() == m_color);
+    return add(mf.max(comp,nghost,true), Max);
+}
+
+ReduceBatch::Future
+ReduceBatch::Dot (const MultiFab& x, int xcomp,
+                  const MultiFab& y, int ycomp,
+                  int numcomp, int nghost)
+{
+    BL_ASSERT(x.color() == m_color);
+    return add(MultiFab::Dot(x,xcomp,y,ycomp,numcomp,nghost,true), Sum);
+}
+
+void
+ReduceBatch::post ()
+{
+    if (numPending() > 0) {
+        m_states.back()->post();
+    }
+}
+
+bool
+ReduceBatch::test ()
+{
+    bool all_done = true;
+
+    for (auto& st : m_states) {
+        if (st->posted && !st->test()) all_done = false;
+    }
+
+    return all_done;
+}
+
+void
+ReduceBatch::wait ()
+{
+    for (auto& st : m_states) {
+        st->wait();
+    }
+    //
+    // Futures still holding a State keep it alive.
+    //
+    m_states.clear();
+}
+
+}
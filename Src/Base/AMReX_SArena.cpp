@@ -0,0 +1,357 @@
+
+#include <algorithm>
+#include <cstdint>
+
+#include <AMReX_SArena.H>
+#include <AMReX.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace amrex {
+
+namespace
+{
+    void update_hwm (std::atomic<long>& hwm, long v)
+    {
+        long old = hwm.load(std::memory_order_relaxed);
+        while (v > old && !hwm.compare_exchange_weak(old, v, std::memory_order_relaxed))
+            ;
+    }
+
+    //
+    // Each thread gets a number the first time it uses an SArena, which
+    // indexes its cache in all of them.
+    //
+    std::atomic<int> num_threads_seen(0);
+
+    int thread_slot ()
+    {
+        static thread_local int slot = num_threads_seen.fetch_add(1);
+        return slot;
+    }
+}
+
+SArena::SArena (size_t hunk_size)
+    :
+    m_hunk_ptr(nullptr),
+    m_hunk_end(nullptr),
+    m_used(0),
+    m_block_bytes(0),
+    m_block_bytes_hwm(0),
+    m_user_bytes(0),
+    m_user_bytes_hwm(0),
+    m_num_allocs(0),
+    m_carved_bytes(0),
+    m_free_bytes_tot_hwm(0)
+{
+    static_assert(sizeof(Header) <= HeaderSize, "SArena: Header too big");
+    static_assert(HeaderSize % Arena::align_size == 0, "SArena: Header breaks alignment");
+
+    for (int cls = 0; cls < NumClasses; ++cls)
+    {
+        m_num_blocks[cls]     = 0;
+        m_num_inuse[cls]      = 0;
+        m_free_bytes_hwm[cls] = 0;
+    }
+    //
+    // Force alignment of hunksize.
+    //
+    m_hunk = Arena::align(hunk_size == 0 ? static_cast<size_t>(DefaultHunkSize) : hunk_size);
+
+    BL_ASSERT(m_hunk >= hunk_size);
+    BL_ASSERT(m_hunk%Arena::align_size == 0);
+
+#ifdef _OPENMP
+    m_cache.resize(omp_get_max_threads());
+#else
+    m_cache.resize(1);
+#endif
+}
+
+SArena::~SArena ()
+{
+    for (unsigned int i = 0, N = m_alloc.size(); i < N; i++)
+        Arena::heap_free(m_alloc[i]);
+}
+
+//
+// Classes are 64 bytes and then four per power of two:
+// (2**k, 2**(k+1)] is split into 2**k + j*2**(k-2), j = 1..4.
+//
+int
+SArena::sizeClass (size_t sz)
+{
+    if (sz <= (size_t(1) << MinLog2)) return 0;
+    const size_t s = sz-1;
+    int k = 0;
+    while ((s >> (k+1)) != 0) ++k;
+    const int sub = (s >> (k-2)) & 3;
+    return 4*(k-MinLog2) + sub + 1;
+}
+
+size_t
+SArena::classSize (int cls)
+{
+    if (cls == 0) return size_t(1) << MinLog2;
+    const int k   = (cls-1)/4 + MinLog2;
+    const int sub = (cls-1)%4;
+    return (size_t(1) << k) + (size_t(sub+1) << (k-2));
+}
+
+//
+// The classes between 64 and 128 bytes are not multiples of a 64 byte
+// align_size; their blocks take the next multiple so that every block
+// carved from a hunk starts aligned.
+//
+size_t
+SArena::blockSize (int cls)
+{
+    return Arena::align(classSize(cls));
+}
+
+long
+SArena::cacheLimit (int cls) const
+{
+    const long n = long((m_hunk/4) / blockSize(cls));
+    return std::max(1L, std::min(n, 64L));
+}
+
+SArena::ThreadCache*
+SArena::threadCache ()
+{
+    const int slot = thread_slot();
+    if (slot < static_cast<int>(m_cache.size()))
+        return &m_cache[slot];
+    return nullptr;
+}
+
+SArena::FreeBlock*
+SArena::carveBlock (int cls)
+{
+    const size_t sz = blockSize(cls);
+
+    m_num_blocks[cls].fetch_add(1, std::memory_order_relaxed);
+    m_carved_bytes.fetch_add(sz, std::memory_order_relaxed);
+
+    if (sz > m_hunk)
+    {
+        void* vp = Arena::heap_alloc(sz);
+        m_alloc.push_back(vp);
+        m_used += sz;
+        return static_cast<FreeBlock*>(vp);
+    }
+
+    if (size_t(m_hunk_end - m_hunk_ptr) < sz)
+    {
+        //
+        // Hand what is left of the current hunk to the smaller classes.
+        //
+        size_t left = m_hunk_end - m_hunk_ptr;
+        while (left >= blockSize(0))
+        {
+            int c = sizeClass(left);
+            while (blockSize(c) > left) --c;
+            FreeBlock* b = reinterpret_cast<FreeBlock*>(m_hunk_ptr);
+            b->next = m_freelist[c].head;
+            m_freelist[c].head = b;
+            ++m_freelist[c].count;
+            m_num_blocks[c].fetch_add(1, std::memory_order_relaxed);
+            m_carved_bytes.fetch_add(blockSize(c), std::memory_order_relaxed);
+            m_hunk_ptr += blockSize(c);
+            left       -= blockSize(c);
+        }
+
+        m_hunk_ptr = static_cast<char*>(Arena::heap_alloc(m_hunk));
+        m_hunk_end = m_hunk_ptr + m_hunk;
+        m_alloc.push_back(m_hunk_ptr);
+        m_used += m_hunk;
+    }
+
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(m_hunk_ptr);
+    m_hunk_ptr += sz;
+    return b;
+}
+
+SArena::FreeBlock*
+SArena::getBlock (int cls)
+{
+    FreeList& fl = m_freelist[cls];
+
+    if (fl.head == nullptr)
+        return carveBlock(cls);
+
+    FreeBlock* b = fl.head;
+    fl.head = b->next;
+    --fl.count;
+    return b;
+}
+
+void*
+SArena::alloc (size_t nbytes)
+{
+    nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+
+    const size_t sz = nbytes + HeaderSize;
+
+    if (sz > (size_t(1) << MaxLog2))
+        amrex::Abort("SArena::alloc: request too large");
+
+    const int cls = sizeClass(sz);
+
+    FreeBlock* b = nullptr;
+
+    ThreadCache* tc = threadCache();
+
+    if (tc)
+    {
+        FreeList& fl = tc->list[cls];
+
+        if (fl.head == nullptr)
+        {
+            //
+            // Refill the thread cache with up to half its capacity.
+            //
+            const long nwant = std::max(1L, cacheLimit(cls)/2);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                FreeList& gl = m_freelist[cls];
+                while (fl.count < nwant-1 && gl.head != nullptr)
+                {
+                    FreeBlock* g = gl.head;
+                    gl.head = g->next;
+                    --gl.count;
+                    g->next = fl.head;
+                    fl.head = g;
+                    ++fl.count;
+                }
+                b = getBlock(cls);
+            }
+        }
+        else
+        {
+            b = fl.head;
+            fl.head = b->next;
+            --fl.count;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        b = getBlock(cls);
+    }
+
+    BL_ASSERT(b != nullptr);
+
+    Header* h = reinterpret_cast<Header*>(b);
+    h->nbytes = nbytes;
+    h->cls    = cls;
+
+    BL_ASSERT(reinterpret_cast<std::uintptr_t>(b) % Arena::align_size == 0);
+
+    m_num_inuse[cls].fetch_add(1, std::memory_order_relaxed);
+    const long bsz = blockSize(cls);
+    const long bb = m_block_bytes.fetch_add(bsz, std::memory_order_relaxed) + bsz;
+    const long ub = m_user_bytes.fetch_add(nbytes, std::memory_order_relaxed) + nbytes;
+    update_hwm(m_block_bytes_hwm, bb);
+    update_hwm(m_user_bytes_hwm, ub);
+    m_num_allocs.fetch_add(1, std::memory_order_relaxed);
+
+    return reinterpret_cast<char*>(b) + HeaderSize;
+}
+
+void
+SArena::free (void* vp)
+{
+    if (vp == 0)
+        //
+        // Allow calls with NULL as allowed by C++ delete.
+        //
+        return;
+
+    Header* h = reinterpret_cast<Header*>(static_cast<char*>(vp) - HeaderSize);
+    const int cls = h->cls;
+
+    BL_ASSERT(cls >= 0 && cls < NumClasses);
+
+    const long bsz = blockSize(cls);
+    const long nfree = m_num_blocks[cls].load(std::memory_order_relaxed)
+        - m_num_inuse[cls].fetch_sub(1, std::memory_order_relaxed) + 1;
+    update_hwm(m_free_bytes_hwm[cls], nfree*bsz);
+    const long bb = m_block_bytes.fetch_sub(bsz, std::memory_order_relaxed) - bsz;
+    update_hwm(m_free_bytes_tot_hwm, m_carved_bytes.load(std::memory_order_relaxed) - bb);
+    m_user_bytes.fetch_sub(h->nbytes, std::memory_order_relaxed);
+
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(h);
+
+    ThreadCache* tc = threadCache();
+
+    if (tc)
+    {
+        FreeList& fl = tc->list[cls];
+        b->next = fl.head;
+        fl.head = b;
+        ++fl.count;
+
+        if (fl.count > cacheLimit(cls))
+        {
+            //
+            // Return half of the thread cache to the shared list.
+            //
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                FreeList& gl = m_freelist[cls];
+                const long nkeep = fl.count/2;
+                while (fl.count > nkeep)
+                {
+                    FreeBlock* g = fl.head;
+                    fl.head = g->next;
+                    --fl.count;
+                    g->next = gl.head;
+                    gl.head = g;
+                    ++gl.count;
+                }
+            }
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeList& gl = m_freelist[cls];
+        b->next = gl.head;
+        gl.head = b;
+        ++gl.count;
+    }
+}
+
+size_t
+SArena::heap_space_used () const
+{
+    return m_used;
+}
+
+SArena::Stats
+SArena::stats () const
+{
+    Stats s;
+    s.heap_bytes      = m_used;
+    s.block_bytes     = m_block_bytes.load();
+    s.block_bytes_hwm = m_block_bytes_hwm.load();
+    s.user_bytes      = m_user_bytes.load();
+    s.user_bytes_hwm  = m_user_bytes_hwm.load();
+    s.num_allocs      = m_num_allocs.load();
+    s.free_bytes      = m_carved_bytes.load() - s.block_bytes;
+    s.free_bytes_hwm  = std::max(m_free_bytes_tot_hwm.load(), s.free_bytes);
+    return s;
+}
+
+std::pair<long,long>
+SArena::freeBytes (int cls) const
+{
+    BL_ASSERT(cls >= 0 && cls < NumClasses);
+    const long cur = (m_num_blocks[cls].load() - m_num_inuse[cls].load()) * long(blockSize(cls));
+    return std::make_pair(cur, std::max(m_free_bytes_hwm[cls].load(), cur));
+}
+
+}
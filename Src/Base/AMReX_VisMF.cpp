@@ -5,7 +5,24 @@
 #include <sstream>
 #include <vector>
 #include <deque>
+#include <set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BL_VISMF_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include <AMReX_ccse-mpi.H>
 #include <AMReX_Utility.H>
@@ -17,6 +34,8 @@
 namespace amrex {
 
 static const char *TheMultiFabHdrFileSuffix = "_H";
+static const char *TheIndexFileSuffix = "_HI";
+static const char *TheStatsFileSuffix = "_S";
 static const char *FabFileSuffix = "_D_";
 static const char *TheFabOnDiskPrefix = "FabOnDisk:";
 
@@ -32,6 +51,11 @@ bool VisMF::checkFilePositions(false);
 bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
+bool VisMF::useMMapReads(false);
+bool VisMF::asyncWrite(false);
+Real VisMF::compressionTolerance(0.0);
+bool VisMF::writeStats(false);
+bool VisMF::verifyStats(false);
 
 long VisMF::ioBufferSize(VisMF::IO_Buffer_Size);
 
@@ -45,6 +69,763 @@ int VisMF::nMFFileInStreams(1);
 namespace
 {
     bool initialized = false;
+
+    //
+    // FAB data staged by an asynchronous Write(), waiting to go out on
+    // a stream that the main thread has already opened.  The ranks of a
+    // file write to it one after another in the static NFilesIter order,
+    // so only nOutFiles ranks write at a time.  A rank passes a token to
+    // the next one in its file when its data are out.
+    //
+    struct StagedWrite
+    {
+        std::string   fileName;
+        std::ofstream os;
+        long          offset;
+        Array<char>   data;
+        int           prevProc;   // ---- -1 if we are first in the file
+        int           nextProc;   // ---- -1 if we are last in the file
+        int           token;
+        ParallelDescriptor::Message tokenMsg;
+    };
+
+    const int asyncOpenTag  = 0;
+    const int asyncWriteTag = 1;
+
+    //
+    // The I/O thread of this rank.  It only does file I/O, so MPI need
+    // not be thread safe.  The tokens are passed by the main thread, in
+    // add(), progress() and finish().
+    //
+    class AsyncWriter
+    {
+    public:
+        ~AsyncWriter ()
+        {
+            //
+            // We get here at exit without VisMF::Finalize, when MPI may
+            // be gone.  Write out what we have without the tokens, the
+            // offsets are known anyway.
+            //
+            for(auto &w : m_waiting) {
+              push(std::move(w));
+            }
+            m_waiting.clear();
+            stop();
+            if( ! m_error.empty()) {
+              std::cerr << m_error << std::endl;
+            }
+        }
+
+        //
+        // Queue a write.  The writes start in the order they are added.
+        //
+        void add (std::unique_ptr<StagedWrite>&& w)
+        {
+            if(w->prevProc >= 0) {
+              w->tokenMsg = ParallelDescriptor::Arecv(&w->token, 1, w->prevProc,
+                                                      asyncWriteTag, comm());
+            }
+            m_waiting.push_back(std::move(w));
+            progress(false);
+        }
+
+        //
+        // Pass on the tokens of the finished writes and start the writes
+        // whose token has come.  With block, wait until all are done.
+        //
+        void progress (bool block)
+        {
+            while(true)
+            {
+              passTokens();
+              while( ! m_waiting.empty()) {
+                StagedWrite &w = *m_waiting.front();
+                if(w.prevProc >= 0 && ! w.tokenMsg.test()) {
+                  break;
+                }
+                push(std::move(m_waiting.front()));
+                m_waiting.pop_front();
+              }
+              if( ! block) {
+                return;
+              }
+              std::unique_lock<std::mutex> lock(m_mutex);
+              if(m_queue.empty() && ! m_busy && m_done.empty()) {
+                if(m_waiting.empty()) {
+                  return;
+                }
+                lock.unlock();
+                m_waiting.front()->tokenMsg.wait();  // ---- nothing else to do
+              } else {
+                m_cv.wait(lock, [this] { return ! m_done.empty(); });
+              }
+            }
+        }
+
+        //
+        // Wait for all the writes, on all the ranks, and raise an error
+        // of the I/O thread here on the main thread.
+        //
+        void finish ()
+        {
+            progress(true);
+            if( ! m_error.empty()) {
+              amrex::Abort(m_error);
+            }
+        }
+
+        void stop ()
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_stop = true;
+                m_cv.notify_all();
+            }
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+            m_done.clear();
+        }
+
+        void freeComm ()
+        {
+#ifdef BL_USE_MPI
+            if(m_comm != MPI_COMM_NULL) {
+              BL_MPI_REQUIRE( MPI_Comm_free(&m_comm) );
+            }
+#endif
+        }
+
+        //
+        // The tokens have a communicator of their own, because they
+        // are in flight across any number of other messages.
+        //
+        MPI_Comm comm ()
+        {
+#ifdef BL_USE_MPI
+            if(m_comm == MPI_COMM_NULL) {
+              BL_MPI_REQUIRE( MPI_Comm_dup(ParallelDescriptor::Communicator(), &m_comm) );
+            }
+            return m_comm;
+#else
+            return ParallelDescriptor::Communicator();
+#endif
+        }
+
+    private:
+        void push (std::unique_ptr<StagedWrite>&& w)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if ( ! m_thread.joinable()) {
+                m_stop = false;
+                m_thread = std::thread(&AsyncWriter::drain, this);
+            }
+            m_queue.push_back(std::move(w));
+            m_cv.notify_all();
+        }
+
+        //
+        // The writes finish in the order they start, so the tokens to
+        // a rank go out in the order it posted the receives.
+        //
+        void passTokens ()
+        {
+            std::deque< std::unique_ptr<StagedWrite> > done;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                done.swap(m_done);
+            }
+            for(auto &w : done) {
+              if(w->nextProc >= 0) {
+                ParallelDescriptor::Send(&w->token, 1, w->nextProc, asyncWriteTag, comm());
+              }
+            }
+        }
+
+        void drain ()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_cv.wait(lock, [this] { return m_stop || ! m_queue.empty(); });
+                if (m_queue.empty()) {
+                    return;  // ---- stopped and drained
+                }
+                std::unique_ptr<StagedWrite> w = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_busy = true;
+                lock.unlock();
+
+                if( ! w->data.empty()) {
+                  w->os.seekp(w->offset, std::ios::beg);
+                  w->os.write(w->data.dataPtr(), w->data.size());
+                  w->os.flush();
+                  const bool failed( ! w->os.good());
+                  w->os.close();
+                  Array<char>().swap(w->data);
+
+                  if(failed) {
+                    lock.lock();
+                    if(m_error.empty()) {
+                      m_error = "VisMF: asynchronous write failed:  " + w->fileName;
+                    }
+                    lock.unlock();
+                  }
+                }
+
+                lock.lock();
+                m_done.push_back(std::move(w));
+                m_busy = false;
+                m_cv.notify_all();
+            }
+        }
+
+        std::deque< std::unique_ptr<StagedWrite> > m_waiting;  // ---- main thread only
+        std::thread                               m_thread;
+        std::mutex                                m_mutex;
+        std::condition_variable                   m_cv;
+        std::deque< std::unique_ptr<StagedWrite> > m_queue;
+        std::deque< std::unique_ptr<StagedWrite> > m_done;
+        std::string                               m_error;
+        bool                                      m_busy = false;
+        bool                                      m_stop = false;
+#ifdef BL_USE_MPI
+        MPI_Comm                                  m_comm = MPI_COMM_NULL;
+#endif
+    };
+
+    AsyncWriter theAsyncWriter;
+
+    //
+    // The renames waiting for the asynchronous writes, (from, to).
+    //
+    std::vector< std::pair<std::string, std::string> > pendingRenames;
+
+    void
+    doPendingRenames ()
+    {
+        if(pendingRenames.empty()) {
+          return;
+        }
+        ParallelDescriptor::Barrier("VisMF::doPendingRenames");  // ---- all the data are out
+        if(ParallelDescriptor::IOProcessor()) {
+          for(const auto &r : pendingRenames) {
+            std::rename(r.first.c_str(), r.second.c_str());
+          }
+        }
+        pendingRenames.clear();
+    }
+
+    //
+    // The rank at setPosition in the write order of file fileNumber,
+    // or -1.
+    //
+    int
+    fileSetProc (int nFiles, int fileNumber, int setPosition, bool groupSets)
+    {
+        const int nProcs(ParallelDescriptor::NProcs());
+        if(setPosition >= 0) {
+          for(int p(0); p < nProcs; ++p) {
+            if(NFilesIter::FileNumber(nFiles, p, groupSets) == fileNumber &&
+               NFilesIter::WhichSetPosition(p, nProcs, nFiles, groupSets) == setPosition)
+            {
+              return p;
+            }
+          }
+        }
+        return -1;
+    }
+
+    //
+    // Open the file of an asynchronous write and queue the data.  The
+    // ranks of a file open it in the static NFilesIter order, the first
+    // one truncates it, so all the ranks must call this.  The stream is
+    // opened here, so that the data land in the file even if the
+    // directory gets renamed before the I/O thread gets to them.
+    //
+    void
+    pushAsyncWrite (std::unique_ptr<StagedWrite>&& w, int nFiles, bool groupSets)
+    {
+        MPI_Comm comm(theAsyncWriter.comm());  // ---- collective the first time
+        const int myProc(ParallelDescriptor::MyProc());
+        const int nProcs(ParallelDescriptor::NProcs());
+        const int myFile(NFilesIter::FileNumber(nFiles, myProc, groupSets));
+        const int mySetPosition(NFilesIter::WhichSetPosition(myProc, nProcs, nFiles, groupSets));
+        w->prevProc = fileSetProc(nFiles, myFile, mySetPosition - 1, groupSets);
+        w->nextProc = fileSetProc(nFiles, myFile, mySetPosition + 1, groupSets);
+        w->token    = myFile;
+
+        if(w->prevProc >= 0) {
+          ParallelDescriptor::Recv(&w->token, 1, w->prevProc, asyncOpenTag, comm);
+        }
+        if(mySetPosition == 0) {
+          w->os.open(w->fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+        } else if( ! w->data.empty()) {
+          w->os.open(w->fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        }
+        if((mySetPosition == 0 || ! w->data.empty()) && ! w->os.good()) {
+          amrex::FileOpenFailed(w->fileName);
+        }
+        if(w->nextProc >= 0) {
+          ParallelDescriptor::Send(&w->token, 1, w->nextProc, asyncOpenTag, comm);
+        }
+
+        theAsyncWriter.add(std::move(w));
+    }
+
+    //
+    // The codecs of Compressed_v1.  A compressed fab is the byte size of
+    // each component, as 8 byte little endian integers, followed by the
+    // components, each coded on its own so they can be read alone.
+    //
+    typedef unsigned char uchar;
+
+    const int CompSizeBytes = 8;
+
+    void
+    putLong (char *p, long v)
+    {
+        for(int b(0); b < CompSizeBytes; ++b) {
+          p[b] = static_cast<char>((static_cast<unsigned long>(v) >> (8*b)) & 0xff);
+        }
+    }
+
+    long
+    getLong (const char *p)
+    {
+        unsigned long v(0);
+        for(int b(0); b < CompSizeBytes; ++b) {
+          v |= static_cast<unsigned long>(static_cast<uchar>(p[b])) << (8*b);
+        }
+        return static_cast<long>(v);
+    }
+
+    //
+    // PackBits style run length coding.  A control byte c < 128 is
+    // followed by c+1 literal bytes, c >= 128 by one byte that is
+    // repeated c-125 times.
+    //
+    void
+    rleEncode (const uchar *in, long n, Array<char> &out)
+    {
+        long i(0);
+        while(i < n) {
+          long r(1);
+          while(i + r < n && r < 130 && in[i+r] == in[i]) {
+            ++r;
+          }
+          if(r >= 3) {
+            out.push_back(static_cast<char>(125 + r));
+            out.push_back(static_cast<char>(in[i]));
+            i += r;
+          } else {
+            const long start(i);
+            long len(0);
+            while(i < n && len < 128) {
+              if(i + 2 < n && in[i] == in[i+1] && in[i] == in[i+2]) {
+                break;
+              }
+              ++i;
+              ++len;
+            }
+            out.push_back(static_cast<char>(len - 1));
+            out.insert(out.end(), in + start, in + start + len);
+          }
+        }
+    }
+
+    void
+    rleDecode (const uchar *in, long nin, uchar *out, long nout)
+    {
+        long i(0), o(0);
+        while(i < nin) {
+          const int c(in[i++]);
+          if(c < 128) {
+            if(o + c + 1 > nout || i + c + 1 > nin) {
+              break;
+            }
+            std::memcpy(out + o, in + i, c + 1);
+            i += c + 1;
+            o += c + 1;
+          } else {
+            if(o + c - 125 > nout || i >= nin) {
+              break;
+            }
+            std::memset(out + o, in[i++], c - 125);
+            o += c - 125;
+          }
+        }
+        if(i != nin || o != nout) {
+          amrex::Abort("VisMF: corrupt compressed fab data");
+        }
+    }
+
+    //
+    // Xor each value of nb bytes with the one before it and split the
+    // result into nb byte planes.  For smooth data the leading planes
+    // are then mostly zeros.
+    //
+    void
+    encodePlanes (const uchar *in, long n, int nb, Array<char> &out)
+    {
+        Array<uchar> planes(n * nb);
+        for(int b(0); b < nb; ++b) {
+          uchar *plane = planes.dataPtr() + b * n;
+          uchar prev(0);
+          for(long i(0); i < n; ++i) {
+            const uchar v(in[i*nb + b]);
+            plane[i] = v ^ prev;
+            prev = v;
+          }
+        }
+        rleEncode(planes.dataPtr(), planes.size(), out);
+    }
+
+    void
+    decodePlanes (const char *in, long nin, long n, int nb, uchar *out)
+    {
+        Array<uchar> planes(n * nb);
+        rleDecode(reinterpret_cast<const uchar *>(in), nin, planes.dataPtr(), planes.size());
+        for(int b(0); b < nb; ++b) {
+          const uchar *plane = planes.dataPtr() + b * n;
+          uchar prev(0);
+          for(long i(0); i < n; ++i) {
+            prev ^= plane[i];
+            out[i*nb + b] = prev;
+          }
+        }
+    }
+
+    //
+    // Quantize to multiples of 2*tol and code the differences of the
+    // integers, zigzag mapped, as 8 byte values.  Returns false if a
+    // value can not be quantized within tol.
+    //
+    bool
+    encodeLossy (const Real *v, long n, Real tol, Array<char> &out)
+    {
+        const Real step(2 * tol);
+        const Real qmax(4503599627370496.0);  // ---- 2^52
+        Array<uchar> deltas(n * CompSizeBytes);
+        long prev(0);
+        for(long i(0); i < n; ++i) {
+          const Real x(v[i] / step);
+          if( ! (std::abs(x) < qmax)) {
+            return false;   // ---- also nan and inf
+          }
+          const long q(std::llround(x));
+          if(std::abs(q * step - v[i]) > tol) {
+            return false;
+          }
+          const long d(q - prev);
+          const unsigned long z((static_cast<unsigned long>(d) << 1) ^ static_cast<unsigned long>(d >> 63));
+          for(int b(0); b < CompSizeBytes; ++b) {
+            deltas[i*CompSizeBytes + b] = static_cast<uchar>((z >> (8*b)) & 0xff);
+          }
+          prev = q;
+        }
+        encodePlanes(deltas.dataPtr(), n, CompSizeBytes, out);
+        return true;
+    }
+
+    void
+    decodeLossy (const char *in, long nin, long n, Real tol, Real *v)
+    {
+        const Real step(2 * tol);
+        Array<uchar> deltas(n * CompSizeBytes);
+        decodePlanes(in, nin, n, CompSizeBytes, deltas.dataPtr());
+        long q(0);
+        for(long i(0); i < n; ++i) {
+          unsigned long z(0);
+          for(int b(0); b < CompSizeBytes; ++b) {
+            z |= static_cast<unsigned long>(deltas[i*CompSizeBytes + b]) << (8*b);
+          }
+          q += static_cast<long>(z >> 1) ^ -static_cast<long>(z & 1);
+          v[i] = q * step;
+        }
+    }
+
+    //
+    // Compress the fab into out and return the codec used.  Codec_None
+    // data are written as rd, as without compression.
+    //
+    int
+    compressFab (const FArrayBox &fab, const RealDescriptor &rd, Real tol, Array<char> &out)
+    {
+        const long npts(fab.box().numPts());
+        const int  ncomp(fab.nComp());
+        const int  nb(rd.numBytes());
+        const long rawBytes(npts * ncomp * nb);
+
+        Array<char> raw(rawBytes);
+        if(rd == FPC::NativeRealDescriptor()) {
+          std::memcpy(raw.dataPtr(), fab.dataPtr(), rawBytes);
+        } else {
+          RealDescriptor::convertFromNativeFormat(static_cast<void *> (raw.dataPtr()),
+                                                  npts * ncomp, fab.dataPtr(), rd);
+        }
+
+        int codec(tol > 0 ? VisMF::Header::Codec_Lossy : VisMF::Header::Codec_Lossless);
+        out.resize(ncomp * CompSizeBytes);
+        for(int n(0); n < ncomp; ++n) {
+          const long start(out.size());
+          if(codec == VisMF::Header::Codec_Lossy &&
+             ! encodeLossy(fab.dataPtr(n), npts, tol, out))
+          {
+            codec = VisMF::Header::Codec_Lossless;   // ---- start over
+            out.resize(ncomp * CompSizeBytes);
+            n = -1;
+            continue;
+          }
+          if(codec == VisMF::Header::Codec_Lossless) {
+            encodePlanes(reinterpret_cast<const uchar *>(raw.dataPtr()) + n * npts * nb,
+                         npts, nb, out);
+          }
+          putLong(out.dataPtr() + n * CompSizeBytes, out.size() - start);
+          if(static_cast<long>(out.size()) >= rawBytes) {
+            break;
+          }
+        }
+
+        if(static_cast<long>(out.size()) >= rawBytes) {
+          out.swap(raw);
+          codec = VisMF::Header::Codec_None;
+        }
+        return codec;
+    }
+
+    //
+    // Decompress the component whichComp, or all of them if whichComp
+    // is -1, of fab index idx from in into fab.  in holds the data from
+    // the start of the first component read.
+    //
+    void
+    decompressFab (const char *in, const VisMF::Header &hdr, int idx,
+                   const Array<long> &compBytes, int whichComp, FArrayBox &fab)
+    {
+        const long npts(fab.box().numPts());
+        const int  nb(hdr.m_writtenRD.numBytes());
+        const int  firstComp(whichComp == -1 ? 0 : whichComp);
+        const int  nComps(fab.nComp());
+        BL_ASSERT(whichComp == -1 ? nComps == hdr.m_ncomp : nComps == 1);
+
+        Array<long> compOffset(nComps, 0);
+        for(int n(1); n < nComps; ++n) {
+          compOffset[n] = compOffset[n-1] + compBytes[firstComp + n - 1];
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int n = 0; n < nComps; ++n) {
+          const char *cin = in + compOffset[n];
+          const long nin(compBytes[firstComp + n]);
+          if(hdr.m_codec[idx] == VisMF::Header::Codec_Lossy) {
+            decodeLossy(cin, nin, npts, hdr.m_tolerance, fab.dataPtr(n));
+          } else if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
+            decodePlanes(cin, nin, npts, nb, reinterpret_cast<uchar *>(fab.dataPtr(n)));
+          } else {
+            Array<uchar> raw(npts * nb);
+            decodePlanes(cin, nin, npts, nb, raw.dataPtr());
+            RealDescriptor::convertToNativeFormat(fab.dataPtr(n), npts,
+                                                  reinterpret_cast<char *>(raw.dataPtr()),
+                                                  hdr.m_writtenRD);
+          }
+        }
+    }
+
+    //
+    // Read component whichComp, or all of them if whichComp is -1, of the
+    // compressed fab idx from the stream, which is at the start of the fab.
+    //
+    void
+    readCompressedFab (std::istream &is, const VisMF::Header &hdr, int idx,
+                       int whichComp, FArrayBox &fab)
+    {
+        const int ncomp(hdr.m_ncomp);
+        Array<char> sizes(ncomp * CompSizeBytes);
+        is.read(sizes.dataPtr(), sizes.size());
+        Array<long> compBytes(ncomp);
+        for(int n(0); n < ncomp; ++n) {
+          compBytes[n] = getLong(sizes.dataPtr() + n * CompSizeBytes);
+        }
+
+        long skip(0), nbytes(0);
+        if(whichComp == -1) {
+          nbytes = hdr.m_nbytes[idx] - sizes.size();
+        } else {
+          for(int n(0); n < whichComp; ++n) {
+            skip += compBytes[n];
+          }
+          nbytes = compBytes[whichComp];
+          is.seekg(skip, std::ios::cur);
+        }
+
+        Array<char> data(nbytes);
+        is.read(data.dataPtr(), nbytes);
+        if( ! is.good()) {
+          amrex::Error("VisMF: read of compressed fab failed");
+        }
+        decompressFab(data.dataPtr(), hdr, idx, compBytes, whichComp, fab);
+    }
+
+    //
+    // The index file of BinaryIndexed_v1.  Every field is an 8 byte
+    // little endian integer, or the bits of a double, as with putLong:
+    //
+    //   "VisMFIdx", the index type of the boxes
+    //   the smallEnd and bigEnd of each box
+    //   for each fab:  the data file number, the offset, the mins, the maxes
+    //
+    // so the record of a fab is at a fixed offset.
+    //
+    const char IndexMagic[] = "VisMFIdx";
+
+    long
+    indexBoxesOffset ()
+    {
+        return 2 * CompSizeBytes;
+    }
+
+    long
+    indexRecordsOffset (long nfabs)
+    {
+        return indexBoxesOffset() + nfabs * 2 * BL_SPACEDIM * CompSizeBytes;
+    }
+
+    long
+    indexRecordBytes (int ncomp)
+    {
+        return (2 + 2 * ncomp) * CompSizeBytes;
+    }
+
+    //
+    // The magic, the index type and the boxes, as at the start of an
+    // index file.  buf has indexRecordsOffset(ba.size()) bytes.
+    //
+    void
+    putBoxes (char *buf, const BoxArray &ba)
+    {
+        std::memcpy(buf, IndexMagic, CompSizeBytes);
+        long itype(0);
+        for(int d(0); d < BL_SPACEDIM; ++d) {
+          itype |= long(ba.ixType().ixType(d)) << d;
+        }
+        putLong(buf + CompSizeBytes, itype);
+
+        char *p = buf + indexBoxesOffset();
+        for(int i(0), N(ba.size()); i < N; ++i, p += 2 * BL_SPACEDIM * CompSizeBytes) {
+          const Box &bx = ba[i];
+          for(int d(0); d < BL_SPACEDIM; ++d) {
+            putLong(p + d * CompSizeBytes, bx.smallEnd(d));
+            putLong(p + (BL_SPACEDIM + d) * CompSizeBytes, bx.bigEnd(d));
+          }
+        }
+    }
+
+    void
+    getBoxes (const char *buf, int nboxes, BoxArray &ba)
+    {
+        const long itype(getLong(buf + CompSizeBytes));
+        IntVect typ;
+        for(int d(0); d < BL_SPACEDIM; ++d) {
+          typ[d] = (itype >> d) & 1;
+        }
+        const IndexType ixtype(typ);
+
+        ba = BoxArray(nboxes);
+        const char *p = buf + indexBoxesOffset();
+        for(int i(0); i < nboxes; ++i, p += 2 * BL_SPACEDIM * CompSizeBytes) {
+          IntVect lo, hi;
+          for(int d(0); d < BL_SPACEDIM; ++d) {
+            lo[d] = getLong(p + d * CompSizeBytes);
+            hi[d] = getLong(p + (BL_SPACEDIM + d) * CompSizeBytes);
+          }
+          ba.set(i, Box(lo, hi, ixtype));
+        }
+    }
+
+    const std::string BinaryBoxArrayTag("BinaryBoxArray:");
+
+    void
+    putDouble (char *p, double d)
+    {
+        std::uint64_t u;
+        std::memcpy(&u, &d, sizeof(u));
+        putLong(p, static_cast<long>(u));
+    }
+
+    double
+    getDouble (const char *p)
+    {
+        std::uint64_t u(static_cast<std::uint64_t>(getLong(p)));
+        double d;
+        std::memcpy(&d, &u, sizeof(d));
+        return d;
+    }
+
+    //
+    // The stats file written with vismf.writestats.  As in the index
+    // file every field is 8 bytes:
+    //
+    //   "VisMFSta", the number of fabs, the number of components
+    //   for each fab and component:  the min, max and sum, the checksum
+    //
+    const char StatsMagic[] = "VisMFSta";
+    const int  nStatsFields(4);
+
+    long
+    statsRecordsOffset ()
+    {
+        return 3 * CompSizeBytes;
+    }
+
+    long
+    statsRecordBytes (int ncomp)
+    {
+        return nStatsFields * ncomp * CompSizeBytes;
+    }
+
+    //
+    // FNV-1a, but a word at a time instead of a byte at a time.
+    //
+    std::uint64_t
+    checksumBytes (const char *p, long nbytes)
+    {
+        const std::uint64_t prime(1099511628211ULL);
+        std::uint64_t h(14695981039346656037ULL);
+        long i(0);
+        for( ; i + 8 <= nbytes; i += 8) {
+          std::uint64_t w;
+          std::memcpy(&w, p + i, sizeof(w));
+          h = (h ^ w) * prime;
+        }
+        for( ; i < nbytes; ++i) {
+          h = (h ^ static_cast<unsigned char>(p[i])) * prime;
+        }
+        return h;
+    }
+
+    //
+    // The checksum of component comp of fab in vbx, of the values as
+    // they read back from disk if written as rd.  Never 0, that is unknown.
+    //
+    std::uint64_t
+    checksumComp (const FArrayBox &fab, const Box &vbx, int comp, const RealDescriptor &rd)
+    {
+        FArrayBox vals(vbx, 1);
+        vals.copy(fab, vbx, comp, vbx, 0, 1);
+        const long n(vbx.numPts());
+        if(rd != FPC::NativeRealDescriptor()) {
+          Array<char> onDisk(n * rd.numBytes());
+          RealDescriptor::convertFromNativeFormat(onDisk.dataPtr(), n, vals.dataPtr(), rd);
+          RealDescriptor::convertToNativeFormat(vals.dataPtr(), n, onDisk.dataPtr(), rd);
+        }
+        std::uint64_t h(checksumBytes(reinterpret_cast<const char *>(vals.dataPtr()),
+                                      n * sizeof(Real)));
+        return h == 0 ? 1 : h;
+    }
 }
 
 void
@@ -82,6 +863,12 @@ VisMF::Initialize ()
     pp.query("usesynchronousreads", useSynchronousReads);
     pp.query("usedynamicsetselection", useDynamicSetSelection);
     pp.query("iobuffersize", ioBufferSize);
+    pp.query("usemmapreads", useMMapReads);
+    pp.query("asyncwrite", asyncWrite);
+    pp.query("compressiontolerance", compressionTolerance);
+    BL_ASSERT(compressionTolerance >= 0);
+    pp.query("writestats", writeStats);
+    pp.query("verifystats", verifyStats);
 
     initialized = true;
 }
@@ -89,9 +876,32 @@ VisMF::Initialize ()
 void
 VisMF::Finalize ()
 {
+    theAsyncWriter.finish();
+    doPendingRenames();
+    theAsyncWriter.stop();
+    theAsyncWriter.freeComm();
+
     initialized = false;
 }
 
+void
+VisMF::FinishAsyncWrites ()
+{
+    BL_PROFILE("VisMF::FinishAsyncWrites");
+    theAsyncWriter.finish();
+    doPendingRenames();
+}
+
+void
+VisMF::RenameWhenWritten (const std::string& from, const std::string& to)
+{
+    if(asyncWrite) {
+      pendingRenames.push_back(std::make_pair(from, to));
+    } else if(ParallelDescriptor::IOProcessor()) {
+      std::rename(from.c_str(), to.c_str());
+    }
+}
+
 void
 VisMF::SetNOutFiles (int noutfiles)
 {
@@ -273,12 +1083,21 @@ operator<< (std::ostream        &os,
     os << hd.m_ncomp    << '\n';
     os << hd.m_ngrow    << '\n';
 
-    hd.m_ba.writeOn(os); os << '\n';
+    if(hd.m_vers == VisMF::Header::BinaryIndexed_v1) {
+      os << hd.m_fod.size()   << '\n';
+      os << hd.m_files.size() << '\n';
+      for(int i(0); i < static_cast<int>(hd.m_files.size()); ++i) {
+        os << hd.m_files[i] << '\n';
+      }
+    } else {
+      hd.m_ba.writeOn(os); os << '\n';
 
-    os << hd.m_fod      << '\n';
+      os << hd.m_fod      << '\n';
+    }
 
-    if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(hd.m_vers == VisMF::Header::Version_v1           ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       os << hd.m_min      << '\n';
       os << hd.m_max      << '\n';
@@ -297,11 +1116,15 @@ operator<< (std::ostream        &os,
       os << '\n';
     }
 
-    if(hd.m_vers == VisMF::Header::NoFabHeader_v1       ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    if(hd.m_vers == VisMF::Header::NoFabHeader_v1         ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1   ||
+       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1          ||
+       hd.m_vers == VisMF::Header::BinaryIndexed_v1)
     {
-      if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
+      if(hd.m_writtenRD != RealDescriptor()) {
+        os << hd.m_writtenRD << '\n';
+      } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
         os << FPC::NativeRealDescriptor() << '\n';
       } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE_32) {
         os << FPC::Native32RealDescriptor() << '\n';
@@ -310,6 +1133,15 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      BL_ASSERT(static_cast<long>(hd.m_codec.size())  == hd.m_ba.size());
+      BL_ASSERT(static_cast<long>(hd.m_nbytes.size()) == hd.m_ba.size());
+      os << hd.m_tolerance << '\n';
+      for(int i(0); i < static_cast<int>(hd.m_codec.size()); ++i) {
+        os << hd.m_codec[i] << ' ' << hd.m_nbytes[i] << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -346,13 +1178,29 @@ operator>> (std::istream  &is,
     is >> hd.m_ngrow;
     BL_ASSERT(hd.m_ngrow >= 0);
 
-    hd.m_ba.readFrom(is);
+    if(hd.m_vers == VisMF::Header::BinaryIndexed_v1) {
+      //
+      // The boxes and the fabs are read by ReadIndexBoxes and ReadIndexFabs.
+      //
+      int nfabs, nfiles;
+      is >> nfabs >> nfiles;
+      hd.m_ba = BoxArray();
+      hd.m_fod.clear();
+      hd.m_fod.resize(nfabs);
+      hd.m_files.resize(nfiles);
+      for(int i(0); i < nfiles; ++i) {
+        is >> hd.m_files[i];
+      }
+    } else {
+      hd.m_ba.readFrom(is);
 
-    is >> hd.m_fod;
-    BL_ASSERT(hd.m_ba.size() == hd.m_fod.size());
+      is >> hd.m_fod;
+      BL_ASSERT(hd.m_ba.size() == static_cast<long>(hd.m_fod.size()));
+    }
 
-    if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(hd.m_vers == VisMF::Header::Version_v1           ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       is >> hd.m_min;
       is >> hd.m_max;
@@ -377,12 +1225,28 @@ operator>> (std::istream  &is,
 	}
       }
     }
-    if(hd.m_vers == VisMF::Header::NoFabHeader_v1       ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    if(hd.m_vers == VisMF::Header::NoFabHeader_v1         ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1   ||
+       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1          ||
+       hd.m_vers == VisMF::Header::BinaryIndexed_v1)
     {
       is >> hd.m_writtenRD;
     }
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+#ifdef BL_USE_FLOAT
+      double dtemp;
+      is >> dtemp;
+      hd.m_tolerance = static_cast<Real>(dtemp);
+#else
+      is >> hd.m_tolerance;
+#endif
+      hd.m_codec.resize(hd.m_ba.size());
+      hd.m_nbytes.resize(hd.m_ba.size());
+      for(int i(0); i < static_cast<int>(hd.m_codec.size()); ++i) {
+        is >> hd.m_codec[i] >> hd.m_nbytes[i];
+      }
+    }
 
 
     if( ! is.good()) {
@@ -493,10 +1357,25 @@ VisMF::max (int nComp) const
     return m_hdr.m_famax[nComp];
 }
 
+int
+VisMF::codec (int fabIndex) const
+{
+    BL_ASSERT(0 <= fabIndex && fabIndex < m_hdr.m_ba.size());
+
+    if(m_hdr.m_codec.size() == 0) {  // ---- not Compressed_v1
+      return Header::Codec_None;
+    }
+
+    return m_hdr.m_codec[fabIndex];
+}
+
 const FArrayBox&
 VisMF::GetFab (int fabIndex,
                int ncomp) const
 {
+    if(m_pa[ncomp][fabIndex] == 0) {
+        m_pa[ncomp][fabIndex] = mapFAB(fabIndex, m_fafabname, ncomp);
+    }
     if(m_pa[ncomp][fabIndex] == 0) {
         m_pa[ncomp][fabIndex] = VisMF::readFAB(fabIndex, m_fafabname, m_hdr, ncomp);
     }
@@ -531,6 +1410,9 @@ FArrayBox*
 VisMF::readFAB (int                idx,
                 const std::string& mf_name)
 {
+    if(FArrayBox *fab = mapFAB(idx, mf_name, -1)) {
+      return fab;
+    }
     return VisMF::readFAB(idx, mf_name, m_hdr, -1);
 }
 
@@ -538,9 +1420,305 @@ FArrayBox*
 VisMF::readFAB (int idx,
 		int ncomp)
 {
+    if(FArrayBox *fab = mapFAB(idx, m_fafabname, ncomp)) {
+      return fab;
+    }
     return VisMF::readFAB(idx, m_fafabname, m_hdr, ncomp);
 }
 
+#ifdef BL_VISMF_MMAP
+//
+// A whole file mapped copy on write, so the fabs using it may be
+// changed without changing the file.
+//
+struct VisMF::MappedFile
+{
+    explicit MappedFile (const std::string &fileName)
+    {
+        int fd(::open(fileName.c_str(), O_RDONLY));
+        if(fd < 0) {
+          return;
+        }
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+          void *p = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+          if(p != MAP_FAILED) {
+            data = static_cast<char *>(p);
+            size = st.st_size;
+          }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile ()
+    {
+        if(data != nullptr) {
+          ::munmap(data, size);
+        }
+    }
+
+    char *data = nullptr;
+    long  size = 0;
+};
+
+//
+// A fab using the data of a MappedFile.  It holds on to the mapping, so
+// it may outlive the VisMF that made it.
+//
+struct VisMF::MappedFab
+    :
+    public FArrayBox
+{
+    MappedFab (const Box &bx, int nComp, Real *p,
+               const std::shared_ptr<MappedFile> &mf)
+        :
+        FArrayBox(bx, nComp, p),
+        mfile(mf)
+    {}
+
+    std::shared_ptr<MappedFile> mfile;
+};
+
+FArrayBox*
+VisMF::mapFAB (int                idx,
+               const std::string &mf_name,
+               int                whichComp) const
+{
+    if( ! useMMapReads) {
+      return nullptr;
+    }
+    if(m_hdr.m_vers == Header::Compressed_v1 && m_hdr.m_codec[idx] != Header::Codec_None) {
+      return nullptr;
+    }
+    if(m_hdr.m_vers != Header::Version_v1 && m_hdr.m_writtenRD != FPC::NativeRealDescriptor()) {
+      return nullptr;
+    }
+
+    const std::string FullName(VisMF::DirName(mf_name) + m_hdr.m_fod[idx].m_name);
+    std::shared_ptr<MappedFile> &mfile = m_mapped[FullName];
+    if( ! mfile) {
+      mfile = std::make_shared<MappedFile>(FullName);
+    }
+    if(mfile->data == nullptr) {
+      return nullptr;
+    }
+
+    const Box fab_box(amrex::grow(m_hdr.m_ba[idx], m_hdr.m_ngrow));
+    const long compBytes(fab_box.numPts() * sizeof(Real));
+    long offset(m_hdr.m_fod[idx].m_head);
+
+    if(m_hdr.m_vers == Header::Version_v1) {
+      //
+      // The data can be used if the fab header is that of a native fab.
+      //
+      std::stringstream hss;
+      hss << "FAB " << FPC::NativeRealDescriptor() << fab_box << ' ' << m_hdr.m_ncomp << '\n';
+      const std::string &fabHeader = hss.str();
+      if(offset + static_cast<long>(fabHeader.size()) > mfile->size ||
+         fabHeader.compare(0, fabHeader.size(), mfile->data + offset, fabHeader.size()) != 0)
+      {
+        return nullptr;
+      }
+      offset += fabHeader.size();
+    }
+
+    int nComp(m_hdr.m_ncomp);
+    if(whichComp != -1) {
+      offset += whichComp * compBytes;
+      nComp = 1;
+    }
+    char *p = mfile->data + offset;
+    if(offset + nComp * compBytes > mfile->size) {
+      return nullptr;
+    }
+    if(reinterpret_cast<std::uintptr_t>(p) % alignof(Real) != 0) {
+      //
+      // The fab headers of Version_v1 can leave the data unaligned.
+      //
+      FArrayBox *fab = new FArrayBox(fab_box, nComp);
+      std::memcpy(fab->dataPtr(), p, nComp * compBytes);
+      return fab;
+    }
+
+    return new MappedFab(fab_box, nComp, reinterpret_cast<Real *>(p), mfile);
+}
+
+#else
+
+//
+// Without mmap everything goes through the stream reader.
+//
+FArrayBox*
+VisMF::mapFAB (int                /*idx*/,
+               const std::string &/*mf_name*/,
+               int                /*whichComp*/) const
+{
+    return nullptr;
+}
+
+#endif
+
+long
+VisMF::readFABRegion (int        idx,
+                      FArrayBox &fab,
+                      const Box &region,
+                      int        srcComp,
+                      int        destComp,
+                      int        numComp) const
+{
+    BL_PROFILE("VisMF::readFABRegion");
+    BL_ASSERT(srcComp >= 0 && numComp >= 1 && srcComp + numComp <= m_hdr.m_ncomp);
+    BL_ASSERT(destComp >= 0 && destComp + numComp <= fab.nComp());
+
+    const Box fab_box(amrex::grow(m_hdr.m_ba[idx], m_hdr.m_ngrow));
+    const Box r(region & fab_box);
+    if( ! r.ok()) {
+      return 0;
+    }
+    BL_ASSERT(fab.box().contains(r));
+
+    const std::string FullName(VisMF::DirName(m_fafabname) + m_hdr.m_fod[idx].m_name);
+    std::ifstream ifs;
+    ifs.rdbuf()->pubsetbuf(0, 0);    // ---- read only the bytes asked for
+    ifs.open(FullName.c_str(), std::ios::in | std::ios::binary);
+    if( ! ifs.good()) {
+      amrex::FileOpenFailed(FullName);
+    }
+
+    long nread(0);
+    long start(m_hdr.m_fod[idx].m_head);
+    RealDescriptor rd(m_hdr.m_writtenRD);
+
+    if(m_hdr.m_vers == Header::Version_v1) {
+      //
+      // Find the data behind the fab header.
+      //
+      char hbuf[1024];
+      ifs.seekg(start, std::ios::beg);
+      ifs.read(hbuf, sizeof(hbuf));
+      const long nhbuf(ifs.gcount());
+      ifs.clear();
+      nread += nhbuf;
+
+      std::istringstream hss(std::string(hbuf, nhbuf));
+      char c;
+      hss >> c >> c >> c >> c;
+      if(c == ':') {
+        //
+        // The "old" fab format may not be binary, read all of it.
+        //
+        std::unique_ptr<FArrayBox> whole(VisMF::readFAB(idx, m_fafabname, m_hdr, -1));
+        fab.copy(*whole, r, srcComp, r, destComp, numComp);
+        return nread + whole->nBytes();
+      }
+      hss.putback(c);
+      Box bx;
+      int nvar;
+      hss >> rd >> bx >> nvar;
+      hss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      if(hss.fail() || bx != fab_box || nvar != m_hdr.m_ncomp) {
+        amrex::Error("VisMF::readFABRegion: bad fab header");
+      }
+      start += hss.tellg();
+
+    } else if(m_hdr.m_vers == Header::Compressed_v1 && m_hdr.m_codec[idx] != Header::Codec_None) {
+      //
+      // Read the components wanted and copy the region out of them.
+      //
+      const int ncomp(m_hdr.m_ncomp);
+      Array<char> sizes(ncomp * CompSizeBytes);
+      ifs.seekg(start, std::ios::beg);
+      ifs.read(sizes.dataPtr(), sizes.size());
+      Array<long> compBytes(ncomp);
+      long skip(0), nbytes(0);
+      for(int n(0); n < ncomp; ++n) {
+        compBytes[n] = getLong(sizes.dataPtr() + n * CompSizeBytes);
+        if(n < srcComp) {
+          skip += compBytes[n];
+        } else if(n < srcComp + numComp) {
+          nbytes += compBytes[n];
+        }
+      }
+      Array<char> data(nbytes);
+      ifs.seekg(skip, std::ios::cur);
+      ifs.read(data.dataPtr(), nbytes);
+      if( ! ifs.good()) {
+        amrex::Error("VisMF::readFABRegion: read of compressed fab failed");
+      }
+
+      FArrayBox tmp(fab_box, 1);
+      long offset(0);
+      for(int n(0); n < numComp; ++n) {
+        decompressFab(data.dataPtr() + offset, m_hdr, idx, compBytes, srcComp + n, tmp);
+        fab.copy(tmp, r, 0, r, destComp + n, 1);
+        offset += compBytes[srcComp + n];
+      }
+      return sizes.size() + nbytes;
+    }
+
+    //
+    // The rows of r, one cell each, in the order they are on disk.  A run
+    // of rows is read at once if the gaps between them are small.
+    //
+    const long npts(fab_box.numPts());
+    const long nb(rd.numBytes());
+    const bool native(rd == FPC::NativeRealDescriptor());
+    const long rowPts(r.length(0));
+    const long maxGap(4096 / nb);
+    const long maxRun(std::max(ioBufferSize / nb, rowPts));
+    Box rows(r);
+    rows.setBig(0, r.smallEnd(0));
+
+    Array<char> buf;
+    std::vector<IntVect> runRows;
+    for(int n(0); n < numComp; ++n) {
+      const long compStart(start + nb * (srcComp + n) * npts);
+      Real *dest = fab.dataPtr(destComp + n);
+      IntVect iv(rows.smallEnd());
+      bool more(true);
+      while(more) {
+        const long runBegin(fab_box.index(iv));
+        long runEnd(runBegin + rowPts);
+        runRows.clear();
+        runRows.push_back(iv);
+        for(;;) {
+          rows.next(iv);
+          if( ! rows.contains(iv)) {
+            more = false;
+            break;
+          }
+          const long next(fab_box.index(iv));
+          if(next - runEnd > maxGap || next + rowPts - runBegin > maxRun) {
+            break;
+          }
+          runRows.push_back(iv);
+          runEnd = next + rowPts;
+        }
+
+        const long runBytes((runEnd - runBegin) * nb);
+        buf.resize(runBytes);
+        ifs.seekg(compStart + runBegin * nb, std::ios::beg);
+        ifs.read(buf.dataPtr(), runBytes);
+        if( ! ifs.good()) {
+          amrex::Error("VisMF::readFABRegion: read failed");
+        }
+        nread += runBytes;
+
+        for(const IntVect &riv : runRows) {
+          char *src = buf.dataPtr() + (fab_box.index(riv) - runBegin) * nb;
+          Real *d = dest + fab.box().index(riv);
+          if(native) {
+            std::memcpy(d, src, rowPts * nb);
+          } else {
+            RealDescriptor::convertToNativeFormat(d, rowPts, src, rd);
+          }
+        }
+      }
+    }
+
+    return nread;
+}
+
 std::string
 VisMF::BaseName (const std::string& filename)
 {
@@ -617,7 +1795,8 @@ VisMF::Write (const FArrayBox&   fab,
 
 VisMF::Header::Header ()
     :
-    m_vers(VisMF::Header::Undefined_v1)
+    m_vers(VisMF::Header::Undefined_v1),
+    m_tolerance(0)
 {}
 
 //
@@ -634,7 +1813,8 @@ VisMF::Header::Header (const FabArray<FArrayBox>& mf,
     m_ncomp(mf.nComp()),
     m_ngrow(mf.nGrow()),
     m_ba(mf.boxArray()),
-    m_fod(m_ba.size())
+    m_fod(m_ba.size()),
+    m_tolerance(0)
 {
     BL_PROFILE("VisMF::Header");
 
@@ -821,65 +2001,593 @@ VisMF::Header::CalculateMinMax (const FabArray<FArrayBox>& mf,
       m_famax[comp] = -std::numeric_limits<Real>::max();
     }
 
-    for(int ibox(0); ibox < m_min.size(); ++ibox) {
-      for(int comp(0); comp < m_min[ibox].size(); ++comp) {
-        m_famin[comp] = std::min(m_famin[comp], m_min[ibox][comp]);
+    for(int ibox(0); ibox < m_min.size(); ++ibox) {
+      for(int comp(0); comp < m_min[ibox].size(); ++comp) {
+        m_famin[comp] = std::min(m_famin[comp], m_min[ibox][comp]);
+      }
+    }
+    for(int ibox(0); ibox < m_max.size(); ++ibox) {
+      for(int comp(0); comp < m_max[ibox].size(); ++comp) {
+        m_famax[comp] = std::max(m_famax[comp], m_max[ibox][comp]);
+      }
+    }
+}
+
+
+long
+VisMF::Header::WriteIndex (const std::string &fafabName) const
+{
+    BL_PROFILE("VisMF::Header::WriteIndex");
+    BL_ASSERT(m_vers == BinaryIndexed_v1);
+
+    const int nfabs(m_ba.size());
+    BL_ASSERT(static_cast<int>(m_fod.size()) == nfabs);
+
+    std::map<std::string, long> fileNumbers;
+    for(int i(0); i < static_cast<int>(m_files.size()); ++i) {
+      fileNumbers[m_files[i]] = i;
+    }
+
+    std::string FullIndexFileName(fafabName + TheIndexFileSuffix);
+
+    VisMF::IO_Buffer io_buffer(ioBufferSize);
+    std::ofstream ifs;
+    ifs.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+    ifs.open(FullIndexFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if( ! ifs.good()) {
+      amrex::FileOpenFailed(FullIndexFileName);
+    }
+
+    Array<char> boxBytes(indexRecordsOffset(nfabs));
+    putBoxes(boxBytes.dataPtr(), m_ba);
+    ifs.write(boxBytes.dataPtr(), boxBytes.size());
+
+    Array<char> rec(indexRecordBytes(m_ncomp));
+    for(int i(0); i < nfabs; ++i) {
+      char *p = rec.dataPtr();
+      putLong(p, fileNumbers[m_fod[i].m_name]);
+      putLong(p + CompSizeBytes, m_fod[i].m_head);
+      for(int n(0); n < m_ncomp; ++n) {
+        const bool hasMinMax(i < static_cast<int>(m_min.size()) &&
+                             n < static_cast<int>(m_min[i].size()));
+        putDouble(p + (2 + n) * CompSizeBytes, hasMinMax ? m_min[i][n] : 0.0);
+        putDouble(p + (2 + m_ncomp + n) * CompSizeBytes, hasMinMax ? m_max[i][n] : 0.0);
+      }
+      ifs.write(p, rec.size());
+    }
+
+    long bytesWritten(VisMF::FileOffset(ifs));
+
+    ifs.flush();
+    if( ! ifs.good()) {
+      amrex::Error("VisMF::Header::WriteIndex:  write failed: " + FullIndexFileName);
+    }
+    ifs.close();
+
+    return bytesWritten;
+}
+
+
+void
+VisMF::Header::ReadIndexBoxes (const std::string &fafabName)
+{
+    BL_PROFILE("VisMF::Header::ReadIndexBoxes");
+    BL_ASSERT(m_vers == BinaryIndexed_v1);
+
+    const int nfabs(m_fod.size());
+    const long nbytes(indexRecordsOffset(nfabs));
+    Array<char> boxBytes(nbytes);
+
+    if(ParallelDescriptor::IOProcessor()) {
+      std::string FullIndexFileName(fafabName + TheIndexFileSuffix);
+      std::ifstream ifs(FullIndexFileName.c_str(), std::ios::in | std::ios::binary);
+      if( ! ifs.good()) {
+        amrex::FileOpenFailed(FullIndexFileName);
+      }
+      ifs.read(boxBytes.dataPtr(), nbytes);
+      if( ! ifs.good() || std::memcmp(boxBytes.dataPtr(), IndexMagic, CompSizeBytes) != 0) {
+        amrex::Error("VisMF::Header::ReadIndexBoxes:  bad index file: " + FullIndexFileName);
+      }
+    }
+    ParallelDescriptor::Bcast(boxBytes.dataPtr(), nbytes, ParallelDescriptor::IOProcessorNumber());
+
+    getBoxes(boxBytes.dataPtr(), nfabs, m_ba);
+}
+
+
+void
+VisMF::Header::ReadIndexFabs (const std::string &fafabName,
+                              const DistributionMapping *dm)
+{
+    const int nfabs(m_fod.size());
+    const int myProc(ParallelDescriptor::MyProc());
+
+    Array<int> whichFabs;
+    whichFabs.reserve(dm == nullptr ? nfabs : nfabs / ParallelDescriptor::NProcs() + 1);
+    for(int i(0); i < nfabs; ++i) {
+      if(dm == nullptr || (*dm)[i] == myProc) {
+        whichFabs.push_back(i);
+      }
+    }
+    ReadIndexFabs(fafabName, whichFabs);
+}
+
+
+void
+VisMF::Header::ReadIndexFabs (const std::string &fafabName,
+                              const Array<int>  &whichFabs)
+{
+    BL_PROFILE("VisMF::Header::ReadIndexFabs");
+    BL_ASSERT(m_vers == BinaryIndexed_v1);
+
+    const int nfabs(m_fod.size());
+    const long recBytes(indexRecordBytes(m_ncomp));
+
+    m_min.clear();
+    m_max.clear();
+    m_min.resize(nfabs);
+    m_max.resize(nfabs);
+    for(int i(0); i < nfabs; ++i) {
+      m_fod[i] = FabOnDisk(std::string(), -1);
+    }
+
+    std::string FullIndexFileName(fafabName + TheIndexFileSuffix);
+    std::ifstream ifs;
+    Array<char> recs;
+
+    for(int w(0), nWhich(whichFabs.size()); w < nWhich; ) {
+      //
+      // Read the records of a run of consecutive fabs at once.
+      //
+      const int iBegin(whichFabs[w]);
+      int wEnd(w + 1);
+      while(wEnd < nWhich && whichFabs[wEnd] == whichFabs[wEnd - 1] + 1) {
+        ++wEnd;
+      }
+      const int iEnd(whichFabs[wEnd - 1] + 1);
+      BL_ASSERT(iBegin >= 0 && iEnd <= nfabs);
+
+      if( ! ifs.is_open()) {
+        ifs.open(FullIndexFileName.c_str(), std::ios::in | std::ios::binary);
+        if( ! ifs.good()) {
+          amrex::FileOpenFailed(FullIndexFileName);
+        }
+      }
+      recs.resize((iEnd - iBegin) * recBytes);
+      ifs.seekg(indexRecordsOffset(nfabs) + iBegin * recBytes, std::ios::beg);
+      ifs.read(recs.dataPtr(), recs.size());
+      if( ! ifs.good()) {
+        amrex::Error("VisMF::Header::ReadIndexFabs:  read failed: " + FullIndexFileName);
+      }
+
+      const char *p = recs.dataPtr();
+      for(int i(iBegin); i < iEnd; ++i, p += recBytes) {
+        const long fileNumber(getLong(p));
+        BL_ASSERT(fileNumber >= 0 && fileNumber < static_cast<long>(m_files.size()));
+        m_fod[i] = FabOnDisk(m_files[fileNumber], getLong(p + CompSizeBytes));
+        m_min[i].resize(m_ncomp);
+        m_max[i].resize(m_ncomp);
+        for(int n(0); n < m_ncomp; ++n) {
+          m_min[i][n] = getDouble(p + (2 + n) * CompSizeBytes);
+          m_max[i][n] = getDouble(p + (2 + m_ncomp + n) * CompSizeBytes);
+        }
+      }
+      w = wEnd;
+    }
+}
+
+
+void
+VisMF::WriteBoxArray (std::ostream      &os,
+                      const BoxArray    &ba,
+                      const std::string &nameInHdr,
+                      const std::string &fullName)
+{
+    BL_PROFILE("VisMF::WriteBoxArray");
+
+    if(currentVersion != VisMF::Header::BinaryIndexed_v1) {
+      ba.writeOn(os);
+      return;
+    }
+
+    std::ofstream bfs(fullName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if( ! bfs.good()) {
+      amrex::FileOpenFailed(fullName);
+    }
+    Array<char> boxBytes(indexRecordsOffset(ba.size()));
+    putBoxes(boxBytes.dataPtr(), ba);
+    bfs.write(boxBytes.dataPtr(), boxBytes.size());
+    bfs.close();
+    if( ! bfs.good()) {
+      amrex::Error("VisMF::WriteBoxArray:  write failed: " + fullName);
+    }
+
+    os << BinaryBoxArrayTag << ' ' << nameInHdr << '\n';
+}
+
+
+void
+VisMF::ReadBoxArray (std::istream      &is,
+                     BoxArray          &ba,
+                     const std::string &dirName,
+                     bool               bReadSpecial)
+{
+    BL_PROFILE("VisMF::ReadBoxArray");
+
+    is >> std::ws;
+    if(is.peek() != BinaryBoxArrayTag[0]) {
+      if(bReadSpecial) {
+        amrex::readBoxArray(ba, is, bReadSpecial);
+      } else {
+        ba.readFrom(is);
+      }
+      return;
+    }
+
+    std::string tag, nameInHdr;
+    is >> tag >> nameInHdr;
+    if(tag != BinaryBoxArrayTag) {
+      amrex::Error("VisMF::ReadBoxArray:  bad tag: " + tag);
+    }
+    std::string fullName(dirName);
+    if( ! fullName.empty() && fullName[fullName.length() - 1] != '/') {
+      fullName += '/';
+    }
+    fullName += nameInHdr;
+    //
+    // The I/O processor reads the file and broadcasts it.
+    //
+    const long boxBytesEach(2 * BL_SPACEDIM * CompSizeBytes);
+    long nbytes(0);
+    Array<char> boxBytes;
+    if(ParallelDescriptor::IOProcessor()) {
+      std::ifstream bfs(fullName.c_str(), std::ios::in | std::ios::binary);
+      if( ! bfs.good()) {
+        amrex::FileOpenFailed(fullName);
+      }
+      bfs.seekg(0, std::ios::end);
+      nbytes = bfs.tellg();
+      bfs.seekg(0, std::ios::beg);
+      boxBytes.resize(nbytes);
+      bfs.read(boxBytes.dataPtr(), nbytes);
+      if( ! bfs.good() || nbytes < indexBoxesOffset() ||
+         (nbytes - indexBoxesOffset()) % boxBytesEach != 0 ||
+         std::memcmp(boxBytes.dataPtr(), IndexMagic, CompSizeBytes) != 0)
+      {
+        amrex::Error("VisMF::ReadBoxArray:  bad box file: " + fullName);
+      }
+    }
+    ParallelDescriptor::Bcast(&nbytes, 1, ParallelDescriptor::IOProcessorNumber());
+    boxBytes.resize(nbytes);
+    ParallelDescriptor::Bcast(boxBytes.dataPtr(), nbytes, ParallelDescriptor::IOProcessorNumber());
+
+    getBoxes(boxBytes.dataPtr(), (nbytes - indexBoxesOffset()) / boxBytesEach, ba);
+}
+
+
+long
+VisMF::WriteHeader (const std::string &mf_name,
+                    VisMF::Header     &hdr,
+		    int                procToWrite)
+{
+    BL_PROFILE("VisMF::WriteHeader");
+    long bytesWritten(0);
+
+    if(ParallelDescriptor::MyProc() == procToWrite) {
+        std::string MFHdrFileName(mf_name);
+
+        MFHdrFileName += TheMultiFabHdrFileSuffix;
+
+        VisMF::IO_Buffer io_buffer(ioBufferSize);
+
+        std::ofstream MFHdrFile;
+
+        MFHdrFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+
+        MFHdrFile.open(MFHdrFileName.c_str(), std::ios::out | std::ios::trunc);
+
+        if( ! MFHdrFile.good()) {
+            amrex::FileOpenFailed(MFHdrFileName);
+	}
+
+        if(hdr.m_vers == VisMF::Header::BinaryIndexed_v1) {
+          std::set<std::string> fileNames;
+          for(int i(0); i < static_cast<int>(hdr.m_fod.size()); ++i) {
+            fileNames.insert(hdr.m_fod[i].m_name);
+          }
+          hdr.m_files.assign(fileNames.begin(), fileNames.end());
+          bytesWritten += hdr.WriteIndex(mf_name);
+        }
+
+        MFHdrFile << hdr;
+
+        //
+        // Add in the number of bytes written out in the Header.
+        //
+        const long hdrBytes(VisMF::FileOffset(MFHdrFile));
+        bytesWritten += hdrBytes;
+
+        MFHdrFile.flush();
+        MFHdrFile.close();
+
+	if(checkFilePositions) {
+          std::stringstream hss;
+	  hss << hdr;
+	  if(hss.tellp() != hdrBytes) {
+	    std::cerr << "**** tellp error: hss.tellp() != bytesWritten :  "
+	              << hss.tellp() << "  " << hdrBytes << std::endl;
+	  }
+	}
+	
+    }
+    return bytesWritten;
+}
+
+
+long
+VisMF::WriteStats (const FabArray<FArrayBox> &mf,
+                   const std::string &mf_name,
+                   const RealDescriptor &whichRD,
+                   bool withChecksums,
+                   int procToWrite)
+{
+    BL_PROFILE("VisMF::WriteStats");
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nComp(mf.nComp());
+    const int nfabs(mf.size());
+    const long recBytes(statsRecordBytes(nComp));
+    //
+    // Make the records of our fabs in the file format, so the
+    // coordinator only has to put them in order.
+    //
+    Array<int> myFabs;
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      myFabs.push_back(mfi.index());
+    }
+    const int nMyFabs(myFabs.size());
+    Array<char> recs(std::max(1L, nMyFabs * recBytes));  // ---- so recs.dataPtr() is valid
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int i = 0; i < nMyFabs; ++i) {
+      const FArrayBox &fab = mf[myFabs[i]];
+      const Box &vbx = mf.box(myFabs[i]);
+      char *p = recs.dataPtr() + i * recBytes;
+      for(int n(0); n < nComp; ++n, p += nStatsFields * CompSizeBytes) {
+        const std::uint64_t h(withChecksums ? checksumComp(fab, vbx, n, whichRD) : 0);
+        putDouble(p,                     fab.min(vbx, n));
+        putDouble(p + CompSizeBytes,     fab.max(vbx, n));
+        putDouble(p + 2 * CompSizeBytes, fab.sum(vbx, n));
+        putLong  (p + 3 * CompSizeBytes, static_cast<long>(h));
+      }
+    }
+
+#ifdef BL_USE_MPI
+    const int nProcs(ParallelDescriptor::NProcs());
+    Array<int> nmtags(nProcs, 0);
+    Array<int> offset(nProcs, 0);
+    const Array<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+    for(int i(0); i < nfabs; ++i) {
+      nmtags[pmap[i]] += recBytes;
+    }
+    for(int i(1); i < nProcs; ++i) {
+      offset[i] = offset[i-1] + nmtags[i-1];
+    }
+    Array<char> allRecs(myProc == procToWrite ? nfabs * recBytes : 1);
+
+    BL_MPI_REQUIRE( MPI_Gatherv(recs.dataPtr(),
+                                nmtags[myProc],
+                                ParallelDescriptor::Mpi_typemap<char>::type(),
+                                allRecs.dataPtr(),
+                                nmtags.dataPtr(),
+                                offset.dataPtr(),
+                                ParallelDescriptor::Mpi_typemap<char>::type(),
+                                procToWrite,
+                                ParallelDescriptor::Communicator()) );
+#endif
+
+    long bytesWritten(0);
+
+    if(myProc == procToWrite) {
+      std::string FullStatsFileName(mf_name + TheStatsFileSuffix);
+
+      VisMF::IO_Buffer io_buffer(ioBufferSize);
+      std::ofstream sfs;
+      sfs.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+      sfs.open(FullStatsFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+      if( ! sfs.good()) {
+        amrex::FileOpenFailed(FullStatsFileName);
+      }
+
+      char head[3 * CompSizeBytes];
+      std::memcpy(head, StatsMagic, CompSizeBytes);
+      putLong(head + CompSizeBytes, nfabs);
+      putLong(head + 2 * CompSizeBytes, nComp);
+      sfs.write(head, statsRecordsOffset());
+
+      for(int j(0); j < nfabs; ++j) {
+#ifdef BL_USE_MPI
+        // ---- the records of a rank are in the order of its fabs
+        sfs.write(allRecs.dataPtr() + offset[pmap[j]], recBytes);
+        offset[pmap[j]] += recBytes;
+#else
+        sfs.write(recs.dataPtr() + j * recBytes, recBytes);
+#endif
+      }
+
+      bytesWritten = VisMF::FileOffset(sfs);
+
+      sfs.flush();
+      if( ! sfs.good()) {
+        amrex::Error("VisMF::WriteStats:  write failed: " + FullStatsFileName);
+      }
+      sfs.close();
+    }
+
+    return bytesWritten;
+}
+
+
+bool
+VisMF::ReadStats (const std::string &mf_name,
+                  Array< Array<FabStats> > &stats,
+                  const DistributionMapping *dm)
+{
+    BL_PROFILE("VisMF::ReadStats");
+
+    std::string FullStatsFileName(mf_name + TheStatsFileSuffix);
+    //
+    // [nfabs, ncomp], nfabs is -1 without a stats file.
+    //
+    long sizes[2] = { -1, 0 };
+
+    if(ParallelDescriptor::IOProcessor()) {
+      std::ifstream ifs(FullStatsFileName.c_str(), std::ios::in | std::ios::binary);
+      if(ifs.good()) {
+        char head[3 * CompSizeBytes];
+        ifs.read(head, statsRecordsOffset());
+        if( ! ifs.good() || std::memcmp(head, StatsMagic, CompSizeBytes) != 0) {
+          amrex::Error("VisMF::ReadStats:  bad stats file: " + FullStatsFileName);
+        }
+        sizes[0] = getLong(head + CompSizeBytes);
+        sizes[1] = getLong(head + 2 * CompSizeBytes);
+      }
+    }
+    ParallelDescriptor::Bcast(sizes, 2, ParallelDescriptor::IOProcessorNumber());
+
+    stats.clear();
+    if(sizes[0] < 0) {
+      return false;
+    }
+
+    const int nfabs(sizes[0]), nComp(sizes[1]);
+    const long recBytes(statsRecordBytes(nComp));
+    stats.resize(nfabs);
+
+    auto getRecord = [&] (int i, const char *p)
+    {
+      stats[i].resize(nComp);
+      for(int n(0); n < nComp; ++n, p += nStatsFields * CompSizeBytes) {
+        stats[i][n].m_min      = getDouble(p);
+        stats[i][n].m_max      = getDouble(p + CompSizeBytes);
+        stats[i][n].m_sum      = getDouble(p + 2 * CompSizeBytes);
+        stats[i][n].m_checksum = static_cast<std::uint64_t>(getLong(p + 3 * CompSizeBytes));
       }
+    };
+
+    Array<char> recs;
+
+    if(dm == nullptr) {
+      recs.resize(std::max(1L, nfabs * recBytes));
+      if(ParallelDescriptor::IOProcessor()) {
+        std::ifstream ifs(FullStatsFileName.c_str(), std::ios::in | std::ios::binary);
+        ifs.seekg(statsRecordsOffset(), std::ios::beg);
+        ifs.read(recs.dataPtr(), nfabs * recBytes);
+        if( ! ifs.good()) {
+          amrex::Error("VisMF::ReadStats:  read failed: " + FullStatsFileName);
+        }
+      }
+      ParallelDescriptor::Bcast(recs.dataPtr(), recs.size(), ParallelDescriptor::IOProcessorNumber());
+      for(int i(0); i < nfabs; ++i) {
+        getRecord(i, recs.dataPtr() + i * recBytes);
+      }
+      return true;
     }
-    for(int ibox(0); ibox < m_max.size(); ++ibox) {
-      for(int comp(0); comp < m_max[ibox].size(); ++comp) {
-        m_famax[comp] = std::max(m_famax[comp], m_max[ibox][comp]);
+
+    BL_ASSERT(dm->size() == nfabs);
+    const int myProc(ParallelDescriptor::MyProc());
+    std::ifstream ifs;
+    int i(0);
+
+    while(i < nfabs) {
+      if((*dm)[i] != myProc) {
+        ++i;
+        continue;
+      }
+      //
+      // Read the records of a run of our fabs at once.
+      //
+      int iEnd(i + 1);
+      while(iEnd < nfabs && (*dm)[iEnd] == myProc) {
+        ++iEnd;
+      }
+
+      if( ! ifs.is_open()) {
+        ifs.open(FullStatsFileName.c_str(), std::ios::in | std::ios::binary);
+        if( ! ifs.good()) {
+          amrex::FileOpenFailed(FullStatsFileName);
+        }
+      }
+      recs.resize((iEnd - i) * recBytes);
+      ifs.seekg(statsRecordsOffset() + i * recBytes, std::ios::beg);
+      ifs.read(recs.dataPtr(), recs.size());
+      if( ! ifs.good()) {
+        amrex::Error("VisMF::ReadStats:  read failed: " + FullStatsFileName);
+      }
+
+      const char *p = recs.dataPtr();
+      for( ; i < iEnd; ++i, p += recBytes) {
+        getRecord(i, p);
       }
     }
+
+    return true;
 }
 
 
-long
-VisMF::WriteHeader (const std::string &mf_name,
-                    VisMF::Header     &hdr,
-		    int                procToWrite)
+Array<int>
+VisMF::FabsInRange (const std::string &mf_name,
+                    int comp, Real lo, Real hi)
 {
-    BL_PROFILE("VisMF::WriteHeader");
-    long bytesWritten(0);
+    BL_PROFILE("VisMF::FabsInRange");
 
-    if(ParallelDescriptor::MyProc() == procToWrite) {
-        std::string MFHdrFileName(mf_name);
+    Array<int> fabs;
+    Array< Array<FabStats> > stats;
 
-        MFHdrFileName += TheMultiFabHdrFileSuffix;
+    if(VisMF::ReadStats(mf_name, stats)) {
+      for(int i(0); i < static_cast<int>(stats.size()); ++i) {
+        BL_ASSERT(comp >= 0 && comp < static_cast<int>(stats[i].size()));
+        if(stats[i][comp].m_max >= lo && stats[i][comp].m_min <= hi) {
+          fabs.push_back(i);
+        }
+      }
+    }
 
-        VisMF::IO_Buffer io_buffer(ioBufferSize);
+    return fabs;
+}
 
-        std::ofstream MFHdrFile;
 
-        MFHdrFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+long
+VisMF::CheckStats (const FabArray<FArrayBox> &mf,
+                   const std::string &mf_name)
+{
+    BL_PROFILE("VisMF::CheckStats");
 
-        MFHdrFile.open(MFHdrFileName.c_str(), std::ios::out | std::ios::trunc);
+    Array< Array<FabStats> > stats;
 
-        if( ! MFHdrFile.good()) {
-            amrex::FileOpenFailed(MFHdrFileName);
-	}
+    if( ! VisMF::ReadStats(mf_name, stats, &mf.DistributionMap())) {
+      return -1;
+    }
 
-        MFHdrFile << hdr;
+    long nBad(0);
 
-        //
-        // Add in the number of bytes written out in the Header.
-        //
-        bytesWritten += VisMF::FileOffset(MFHdrFile);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      const int idx(mfi.index());
+      const int nComp(std::min<int>(mf.nComp(), stats[idx].size()));
+      for(int n(0); n < nComp; ++n) {
+        const std::uint64_t h(stats[idx][n].m_checksum);
+        if(h != 0 && h != checksumComp(mf[mfi], mfi.validbox(), n, FPC::NativeRealDescriptor())) {
+          ++nBad;
+        }
+      }
+    }
 
-        MFHdrFile.flush();
-        MFHdrFile.close();
+    ParallelDescriptor::ReduceLongSum(nBad);
 
-	if(checkFilePositions) {
-          std::stringstream hss;
-	  hss << hdr;
-	  if(hss.tellp() != bytesWritten) {
-	    std::cerr << "**** tellp error: hss.tellp() != bytesWritten :  "
-	              << hss.tellp() << "  " << bytesWritten << std::endl;
-	  }
-	}
-	
-    }
-    return bytesWritten;
+    return nBad;
 }
 
 long
@@ -892,6 +2600,8 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
     BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
 
+    theAsyncWriter.progress(false);  // ---- pass on the turns of earlier writes
+
     // ---- add stream retry
     // ---- add stream buffer (to nfiles)
     RealDescriptor *whichRD;
@@ -920,6 +2630,26 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         }
     }
 
+    if(currentVersion == VisMF::Header::Compressed_v1) {
+      if(FArrayBox::getFormat() == FABio::FAB_ASCII ||
+         FArrayBox::getFormat() == FABio::FAB_8BIT)
+      {
+        amrex::Abort("VisMF::Write:  Compressed_v1 needs a binary FArrayBox format");
+      }
+      long bytes = VisMF::WriteCompressed(mf, mf_name, how, *whichRD, asyncWrite);
+      delete whichRD;
+      return bytes;
+    }
+
+    if(asyncWrite &&
+       FArrayBox::getFormat() != FABio::FAB_ASCII &&
+       FArrayBox::getFormat() != FABio::FAB_8BIT)
+    {
+      long bytes = VisMF::WriteAsync(mf, mf_name, how, *whichRD);
+      delete whichRD;
+      return bytes;
+    }
+
     int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
     long bytesWritten(0);
     bool calcMinMax(false);
@@ -1021,8 +2751,9 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
       coordinatorProc = nfi.CoordinatorProc();
     }
 
-    if(currentVersion == VisMF::Header::Version_v1 ||
-       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(currentVersion == VisMF::Header::Version_v1           ||
+       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       currentVersion == VisMF::Header::BinaryIndexed_v1)
     {
       hdr.CalculateMinMax(mf, coordinatorProc);
     }
@@ -1032,20 +2763,359 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
     bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
 
+    if(writeStats) {
+      bytesWritten += VisMF::WriteStats(mf, mf_name, *whichRD, true, coordinatorProc);
+    }
+
     delete whichRD;
 
     return bytesWritten;
 }
 
 
+long
+VisMF::WriteAsync (const FabArray<FArrayBox>& mf,
+                   const std::string&         mf_name,
+                   VisMF::How                 how,
+                   const RealDescriptor&      whichRD)
+{
+    BL_PROFILE("VisMF::WriteAsync");
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    const bool doConvert(whichRD != FPC::NativeRealDescriptor());
+    const bool oldHeader(currentVersion == VisMF::Header::Version_v1);
+    const FABio &fio = FArrayBox::getFABio();
+    const int whichRDBytes(whichRD.numBytes());
+    const int nComp(mf.nComp());
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, how, currentVersion, calcMinMax);
+
+    if(currentVersion == VisMF::Header::Version_v1           ||
+       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       currentVersion == VisMF::Header::BinaryIndexed_v1)
+    {
+      hdr.CalculateMinMax(mf, coordinatorProc);
+    }
+    //
+    // The ranks of a file write to it in rank order, as with static set
+    // selection, so the offset of our data is the size of the data of
+    // the ranks before us in the file.
+    //
+    auto fabBytes = [&] (int i) -> long
+    {
+      long b = mf.fabbox(i).numPts() * nComp * whichRDBytes;
+      if(oldHeader) {
+        std::stringstream hss;
+        FArrayBox tempFab(mf.fabbox(i), nComp, false);  // ---- no alloc
+        fio.write_header(hss, tempFab, nComp);
+        b += hss.tellp();
+      }
+      return b;
+    };
+
+    const std::string filePrefix(mf_name + FabFileSuffix);
+    const int nFiles(NFilesIter::ActualNFiles(nOutFiles));
+    const int myFile(NFilesIter::FileNumber(nFiles, myProc, groupSets));
+    const DistributionMapping &dm = mf.DistributionMap();
+
+    long myOffset(0);
+    for(int i(0), N(mf.size()); i < N; ++i) {
+      if(dm[i] < myProc && NFilesIter::FileNumber(nFiles, dm[i], groupSets) == myFile) {
+        myOffset += fabBytes(i);
+      }
+    }
+    //
+    // Snapshot our fabs into the staging buffer.
+    //
+    std::unique_ptr<StagedWrite> w(new StagedWrite);
+    w->fileName = NFilesIter::FileName(myFile, filePrefix);
+    w->offset   = myOffset;
+
+    long nBytes(0);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      nBytes += fabBytes(mfi.index());
+    }
+    w->data.resize(nBytes);
+
+    long writePosition(0);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      const FArrayBox &fab = mf[mfi];
+      const long writeDataItems = fab.box().numPts() * nComp;
+      char *afPtr = w->data.dataPtr() + writePosition;
+      if(oldHeader) {
+        std::stringstream hss;
+        fio.write_header(hss, fab, fab.nComp());
+        const int hLength = hss.tellp();
+        memcpy(afPtr, hss.str().c_str(), hLength);  // ---- the fab header
+        afPtr += hLength;
+        writePosition += hLength;
+      }
+      if(doConvert) {
+        RealDescriptor::convertFromNativeFormat(static_cast<void *> (afPtr),
+                                                writeDataItems,
+                                                fab.dataPtr(), whichRD);
+      } else {
+        memcpy(afPtr, fab.dataPtr(), writeDataItems * whichRDBytes);
+      }
+      writePosition += writeDataItems * whichRDBytes;
+    }
+    BL_ASSERT(writePosition == nBytes);
+
+    pushAsyncWrite(std::move(w), nFiles, groupSets);
+
+    NFilesIter nfi(nOutFiles, filePrefix, groupSets, false);
+    VisMF::FindOffsets(mf, filePrefix, hdr, groupSets, currentVersion, false, nfi, &whichRD);
+
+    long bytesWritten = nBytes + VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    if(writeStats) {
+      bytesWritten += VisMF::WriteStats(mf, mf_name, whichRD, true, coordinatorProc);
+    }
+
+    return bytesWritten;
+}
+
+
+long
+VisMF::WriteCompressed (const FabArray<FArrayBox>& mf,
+                        const std::string&         mf_name,
+                        VisMF::How                 how,
+                        const RealDescriptor&      whichRD,
+                        bool                       async)
+{
+    BL_PROFILE("VisMF::WriteCompressed");
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nProcs(ParallelDescriptor::NProcs());
+    const int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    const Real tol(compressionTolerance);
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, how, VisMF::Header::Compressed_v1, calcMinMax);
+    hdr.m_writtenRD = whichRD;
+    hdr.m_tolerance = tol;
+    hdr.CalculateMinMax(mf, coordinatorProc);
+    //
+    // Compress our fabs, each on its own so they can be read alone.
+    //
+    Array<int> myFabs;
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      myFabs.push_back(mfi.index());
+    }
+    const int nMyFabs(myFabs.size());
+    Array< Array<char> > packed(nMyFabs);
+    Array<int> codec(nMyFabs);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int i = 0; i < nMyFabs; ++i) {
+      codec[i] = compressFab(mf[myFabs[i]], whichRD, tol, packed[i]);
+    }
+
+    long nBytes(0);
+    for(int i(0); i < nMyFabs; ++i) {
+      nBytes += packed[i].size();
+    }
+    //
+    // [head, nbytes, codec, file number] of each of our fabs.
+    //
+    const int nInfo(4);
+    Array<long> info(nMyFabs * nInfo);
+    const std::string filePrefix(mf_name + FabFileSuffix);
+
+    if(async) {
+      //
+      // The ranks of a file write to it in rank order, so our offset
+      // is the bytes of the ranks before us in the file.
+      //
+      const int nFiles(NFilesIter::ActualNFiles(nOutFiles));
+      const int myFile(NFilesIter::FileNumber(nFiles, myProc, groupSets));
+      Array<long> allBytes(nProcs, 0);
+      allBytes[myProc] = nBytes;
+      ParallelDescriptor::ReduceLongSum(allBytes.dataPtr(), nProcs);
+
+      long head(0);
+      for(int p(0); p < myProc; ++p) {
+        if(NFilesIter::FileNumber(nFiles, p, groupSets) == myFile) {
+          head += allBytes[p];
+        }
+      }
+
+      std::unique_ptr<StagedWrite> w(new StagedWrite);
+      w->fileName = NFilesIter::FileName(myFile, filePrefix);
+      w->offset   = head;
+      w->data.reserve(nBytes);
+      for(int i(0); i < nMyFabs; ++i) {
+        info[i*nInfo + 0] = head;
+        info[i*nInfo + 1] = packed[i].size();
+        info[i*nInfo + 2] = codec[i];
+        info[i*nInfo + 3] = myFile;
+        head += packed[i].size();
+        w->data.insert(w->data.end(), packed[i].begin(), packed[i].end());
+        Array<char>().swap(packed[i]);
+      }
+
+      pushAsyncWrite(std::move(w), nFiles, groupSets);
+
+    } else {
+
+      NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
+      if(useDynamicSetSelection) {
+        nfi.SetDynamic();
+      }
+      for( ; nfi.ReadyToWrite(); ++nfi) {
+        long head(VisMF::FileOffset(nfi.Stream()));
+        for(int i(0); i < nMyFabs; ++i) {
+          info[i*nInfo + 0] = head;
+          info[i*nInfo + 1] = packed[i].size();
+          info[i*nInfo + 2] = codec[i];
+          info[i*nInfo + 3] = nfi.FileNumber();
+          head += packed[i].size();
+          nfi.Stream().write(packed[i].dataPtr(), packed[i].size());
+        }
+        nfi.Stream().flush();
+      }
+    }
+    //
+    // Gather the fab info in the header on the coordinator.
+    //
+    hdr.m_codec.resize(mf.size(), VisMF::Header::Codec_None);
+    hdr.m_nbytes.resize(mf.size(), 0);
+
+#ifdef BL_USE_MPI
+    Array<int> nmtags(nProcs, 0);
+    Array<int> offset(nProcs, 0);
+    const Array<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+    for(int i(0), N(mf.size()); i < N; ++i) {
+      nmtags[pmap[i]] += nInfo;
+    }
+    for(int i(1); i < nProcs; ++i) {
+      offset[i] = offset[i-1] + nmtags[i-1];
+    }
+    if(info.empty()) {
+      info.resize(1);  // ---- so info.dataPtr() is valid
+    }
+    Array<long> allInfo(mf.size() * nInfo);
+
+    BL_MPI_REQUIRE( MPI_Gatherv(info.dataPtr(),
+                                nmtags[myProc],
+                                ParallelDescriptor::Mpi_typemap<long>::type(),
+                                allInfo.dataPtr(),
+                                nmtags.dataPtr(),
+                                offset.dataPtr(),
+                                ParallelDescriptor::Mpi_typemap<long>::type(),
+                                coordinatorProc,
+                                ParallelDescriptor::Communicator()) );
+
+    if(myProc == coordinatorProc) {
+      for(int j(0), N(mf.size()); j < N; ++j) {
+        const long *fi = allInfo.dataPtr() + offset[pmap[j]];
+        offset[pmap[j]] += nInfo;
+        hdr.m_fod[j] = VisMF::FabOnDisk(VisMF::BaseName(NFilesIter::FileName(fi[3], filePrefix)),
+                                        fi[0]);
+        hdr.m_nbytes[j] = fi[1];
+        hdr.m_codec[j]  = fi[2];
+      }
+    }
+#else
+    for(int i(0); i < nMyFabs; ++i) {
+      const long *fi = info.dataPtr() + i * nInfo;
+      hdr.m_fod[myFabs[i]] = VisMF::FabOnDisk(VisMF::BaseName(NFilesIter::FileName(fi[3], filePrefix)),
+                                              fi[0]);
+      hdr.m_nbytes[myFabs[i]] = fi[1];
+      hdr.m_codec[myFabs[i]]  = fi[2];
+    }
+#endif
+
+    long bytesWritten = nBytes + VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    if(writeStats) {
+      // ---- lossy fabs do not read back as they are
+      bytesWritten += VisMF::WriteStats(mf, mf_name, whichRD, tol == 0, coordinatorProc);
+    }
+
+    return bytesWritten;
+}
+
+
+long
+VisMF::Write (const FabArray<FloatArrayBox>& mf,
+              const std::string& mf_name,
+              VisMF::How         how)
+{
+    BL_PROFILE("VisMF::Write_FloatFabArray");
+    BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
+
+    const RealDescriptor &whichRD = FPC::Native32RealDescriptor();
+    BL_ASSERT(whichRD.numBytes() == sizeof(float));
+
+    VisMF::Header hdr;
+    hdr.m_vers  = VisMF::Header::NoFabHeaderFAMinMax_v1;
+    hdr.m_how   = how;
+    hdr.m_ncomp = mf.nComp();
+    hdr.m_ngrow = mf.nGrow();
+    hdr.m_ba    = mf.boxArray();
+    hdr.m_fod.resize(hdr.m_ba.size());
+    hdr.m_writtenRD = whichRD;
+
+    hdr.m_famin.resize(hdr.m_ncomp,  std::numeric_limits<Real>::max());
+    hdr.m_famax.resize(hdr.m_ncomp, -std::numeric_limits<Real>::max());
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      const int idx = mfi.index();
+      for(int i(0); i < hdr.m_ncomp; ++i) {
+        hdr.m_famin[i] = std::min(hdr.m_famin[i], Real(mf[mfi].min(hdr.m_ba[idx],i)));
+        hdr.m_famax[i] = std::max(hdr.m_famax[i], Real(mf[mfi].max(hdr.m_ba[idx],i)));
+      }
+    }
+    ParallelDescriptor::ReduceRealMin(hdr.m_famin.dataPtr(), hdr.m_famin.size());
+    ParallelDescriptor::ReduceRealMax(hdr.m_famax.dataPtr(), hdr.m_famax.size());
+
+    int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    long bytesWritten(0);
+
+    std::string filePrefix(mf_name + FabFileSuffix);
+
+    NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
+
+    if(useDynamicSetSelection) {
+      nfi.SetDynamic();
+    }
+    for( ; nfi.ReadyToWrite(); ++nfi) {
+      for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const FloatArrayBox &fab = mf[mfi];
+        const long writeDataSize(fab.box().numPts() * mf.nComp() * sizeof(float));
+        nfi.Stream().write((const char *) fab.dataPtr(), writeDataSize);
+        bytesWritten += writeDataSize;
+      }
+      nfi.Stream().flush();
+    }
+
+    if(useDynamicSetSelection) {
+      coordinatorProc = nfi.CoordinatorProc();
+    }
+
+    VisMF::FindOffsets(mf, filePrefix, hdr, groupSets, VisMF::Header::NoFabHeaderFAMinMax_v1,
+		       useDynamicSetSelection, nfi, &whichRD);
+
+    bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    return bytesWritten;
+}
+
+
 void
-VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
+VisMF::FindOffsets (const FabArrayBase &mf,
 		    const std::string &filePrefix,
                     VisMF::Header &hdr,
 		    bool groupSets,
 		    VisMF::Header::Version whichVersion,
 		    bool useDynamicSetSelection,
-		    NFilesIter &nfi)
+		    NFilesIter &nfi,
+		    const RealDescriptor *rd)
 {
     BL_PROFILE("VisMF::FindOffsets");
 
@@ -1056,8 +3126,9 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
       coordinatorProc = nfi.CoordinatorProc();
     }
 
-    if(FArrayBox::getFormat() == FABio::FAB_ASCII ||
-       FArrayBox::getFormat() == FABio::FAB_8BIT)
+    if(rd == nullptr &&
+       (FArrayBox::getFormat() == FABio::FAB_ASCII ||
+        FArrayBox::getFormat() == FABio::FAB_8BIT))
     {
 #ifdef BL_USE_MPI
     Array<int> nmtags(nProcs,0);
@@ -1126,7 +3197,9 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
     } else {    // ---- calculate offsets
 
       RealDescriptor *whichRD;
-      if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
+      if(rd != nullptr) {
+        whichRD = rd->clone();
+      } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
         whichRD = FPC::NativeRealDescriptor().clone();
       } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE_32) {
         whichRD = FPC::Native32RealDescriptor().clone();
@@ -1212,6 +3285,11 @@ VisMF::RemoveFiles(const std::string &mf_name, bool verbose)
 	            << strerror(errno) << std::endl;
         }
       }
+      // ---- only BinaryIndexed_v1 has an index file, and only vismf.writestats a stats file
+      std::string IndexFileName(mf_name + TheIndexFileSuffix);
+      std::remove(IndexFileName.c_str());
+      std::string StatsFileName(mf_name + TheStatsFileSuffix);
+      std::remove(StatsFileName.c_str());
       for(int ip(0); ip < nOutFiles; ++ip) {
         std::string fileName(NFilesIter::FileName(nOutFiles, mf_name + FabFileSuffix, ip, true));
         if(verbose) {
@@ -1229,7 +3307,8 @@ VisMF::RemoveFiles(const std::string &mf_name, bool verbose)
 }
 
 
-VisMF::VisMF (const std::string &fafab_name)
+VisMF::VisMF (const std::string &fafab_name,
+              const FabArrayBase *onto)
     :
     m_fafabname(fafab_name)
 {
@@ -1244,6 +3323,37 @@ VisMF::VisMF (const std::string &fafab_name)
 
     infs >> m_hdr;
 
+    if(m_hdr.m_vers == Header::BinaryIndexed_v1) {
+      m_hdr.ReadIndexBoxes(m_fafabname);
+      if(onto == nullptr) {
+        m_hdr.ReadIndexFabs(m_fafabname);
+      } else {
+        //
+        // Only the records of the fabs on disk that, with their ghost
+        // cells, intersect the fabs of onto on this process.
+        //
+        BoxArray gba(m_hdr.m_ba);
+        gba.grow(m_hdr.m_ngrow);
+        const int nfabs(gba.size());
+        Array<char> wanted(nfabs, 0);
+        std::vector< std::pair<int,Box> > isects;
+        const Array<int> &myFabs = onto->IndexArray();
+        for(int k(0), N(myFabs.size()); k < N; ++k) {
+          gba.intersections(onto->fabbox(myFabs[k]), isects);
+          for(int i(0), NI(isects.size()); i < NI; ++i) {
+            wanted[isects[i].first] = 1;
+          }
+        }
+        Array<int> whichFabs;
+        for(int i(0); i < nfabs; ++i) {
+          if(wanted[i]) {
+            whichFabs.push_back(i);
+          }
+        }
+        m_hdr.ReadIndexFabs(m_fafabname, whichFabs);
+      }
+    }
+
     m_pa.resize(m_hdr.m_ncomp);
 
     for(int nComp(0); nComp < m_pa.size(); ++nComp) {
@@ -1287,6 +3397,8 @@ VisMF::readFAB (int                  idx,
       } else {
         fab->readFrom(*infs, whichComp);
       }
+    } else if(hdr.m_vers == Header::Compressed_v1 && hdr.m_codec[idx] != Header::Codec_None) {
+      readCompressedFab(*infs, hdr, idx, whichComp, *fab);
     } else {
       if(whichComp == -1) {    // ---- read all components
 	if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
@@ -1331,7 +3443,9 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(NoFabHeader(hdr)) {
+    if(hdr.m_vers == Header::Compressed_v1 && hdr.m_codec[idx] != Header::Codec_None) {
+      readCompressedFab(*infs, hdr, idx, -1, fab);
+    } else if(NoFabHeader(hdr)) {
       if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
         infs->read((char *) fab.dataPtr(), fab.nBytes());
       } else {
@@ -1382,6 +3496,10 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 
         infs >> hdr;
 
+        if(hdr.m_vers == VisMF::Header::BinaryIndexed_v1) {
+          hdr.ReadIndexBoxes(mf_name);
+        }
+
         hEndTime = ParallelDescriptor::second();
     }
 
@@ -1392,6 +3510,12 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 	BL_ASSERT(amrex::match(hdr.m_ba,mf.boxArray()));
     }
 
+    if(hdr.m_vers == VisMF::Header::BinaryIndexed_v1) {
+      // ---- reading in file order and the coordinator need the offsets of all the fabs
+      bool allFabs(useSynchronousReads || myProc == coordinatorProc);
+      hdr.ReadIndexFabs(mf_name, allFabs ? nullptr : &mf.DistributionMap());
+    }
+
 #ifdef BL_USE_MPI
 
   // ---- This limits the number of concurrent readers per file.
@@ -1399,7 +3523,8 @@ VisMF::Read (FabArray<FArrayBox> &mf,
   int nProcs(ParallelDescriptor::NProcs());
   bool noFabHeader(NoFabHeader(hdr));
 
-  if(noFabHeader && useSynchronousReads) {
+  // ---- compressed fabs vary in size, they are read one at a time
+  if(noFabHeader && useSynchronousReads && hdr.m_vers != VisMF::Header::Compressed_v1) {
 
     // ---- This code is only for reading in file order
     bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
@@ -1790,6 +3915,68 @@ VisMF::Read (FabArray<FArrayBox> &mf,
     }
 
     BL_ASSERT(mf.ok());
+
+    if(verifyStats) {
+      const long nBad(VisMF::CheckStats(mf, mf_name));
+      if(nBad > 0) {
+        amrex::Abort("VisMF::Read:  " + std::to_string(nBad)
+                     + " fab components differ from the stats file of " + mf_name);
+      }
+    }
+}
+
+
+void
+VisMF::ReadOnto (FabArray<FArrayBox> &mf,
+                 const std::string   &mf_name)
+{
+    BL_PROFILE("VisMF::ReadOnto()");
+
+    Real startTime(ParallelDescriptor::second());
+
+    VisMF vmf(mf_name, &mf);
+
+    const BoxArray& fba    = vmf.boxArray();
+    const int       fngrow = vmf.nGrow();
+    const int       ncomp  = std::min(mf.nComp(), vmf.nComp());
+    BoxArray fgba(fba);
+    fgba.grow(fngrow);
+
+    long nBytes(0);
+    std::vector< std::pair<int,Box> > isects;
+
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      FArrayBox &fab = mf[mfi];
+      const Box &bx  = fab.box();
+      fab.setVal(0.0);
+      //
+      // The valid cells on disk, then what only their ghost cells cover.
+      //
+      fba.intersections(bx, isects);
+      for(int i(0), N(isects.size()); i < N; ++i) {
+        nBytes += vmf.readFABRegion(isects[i].first, fab, isects[i].second, 0, 0, ncomp);
+      }
+      if(fngrow > 0) {
+        const BoxList rest(fba.complementIn(bx));
+        for(BoxList::const_iterator bli = rest.begin(); bli != rest.end(); ++bli) {
+          fgba.intersections(*bli, isects);
+          for(int i(0), N(isects.size()); i < N; ++i) {
+            nBytes += vmf.readFABRegion(isects[i].first, fab, isects[i].second, 0, 0, ncomp);
+          }
+        }
+      }
+    }
+
+    if(verbose) {
+      ParallelDescriptor::ReduceLongSum(nBytes);
+      Real readTime(ParallelDescriptor::second() - startTime);
+      ParallelDescriptor::ReduceRealMax(readTime);
+      if(ParallelDescriptor::IOProcessor()) {
+        std::cout << "VisMF::ReadOnto:  " << mf_name << ":  nBoxes on disk = " << fba.size()
+                  << "  nBoxes = " << mf.size() << "  bytes read = " << nBytes
+                  << "  time = " << readTime << std::endl;
+      }
+    }
 }
 
 
@@ -1915,9 +4102,11 @@ VisMF::clear ()
 
 
 bool VisMF::NoFabHeader(const VisMF::Header &hdr) {
-  if(hdr.m_vers == VisMF::Header::NoFabHeader_v1       ||
-    hdr.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+  if(hdr.m_vers == VisMF::Header::NoFabHeader_v1         ||
+    hdr.m_vers == VisMF::Header::NoFabHeaderMinMax_v1   ||
+    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+    hdr.m_vers == VisMF::Header::Compressed_v1          ||
+    hdr.m_vers == VisMF::Header::BinaryIndexed_v1)
   {
     return true;
   }
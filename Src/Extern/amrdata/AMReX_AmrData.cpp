@@ -106,6 +106,7 @@ namespace amrex {
 bool AmrData::verbose = false;
 int  AmrData::skipPltLines  = 0;
 int  AmrData::sBoundaryWidth = 0;
+bool AmrData::selectiveReads = false;
 
 // ---------------------------------------------------------------
 AmrData::AmrData() {
@@ -476,6 +477,7 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
 
    dataGrids.resize(finestLevel + 1);
    dataGridsDefined.resize(finestLevel + 1);
+   dataGridsRegions.resize(finestLevel + 1);
 
    int lev;
    boundaryWidth = std::max(width, sBoundaryWidth);
@@ -576,6 +578,7 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
       int currentVisMF(0);
       dataGrids[i].resize(nComp);
       dataGridsDefined[i].resize(nComp);
+      dataGridsRegions[i].resize(nComp);
 
       std::unique_ptr<DistributionMapping> dmap;
 
@@ -610,6 +613,7 @@ bool AmrData::ReadData(const string &filename, Amrvis::FileType filetype) {
 					     Fab_noallocate);
           dataGridsDefined[i][iComp].resize(visMF[i][currentVisMF]->size(),
 					    false);
+          dataGridsRegions[i][iComp].resize(visMF[i][currentVisMF]->size());
           compIndexToVisMFMap[iComp] = currentVisMF;
           compIndexToVisMFComponentMap[iComp] = currentVisMFComponent;
           ++currentVisMFComponent;
@@ -840,6 +844,7 @@ bool AmrData::ReadNonPlotfileData(const string &filename, Amrvis::FileType filet
 
   dataGrids.resize(finestLevel + 1);
   dataGridsDefined.resize(finestLevel + 1);
+  dataGridsRegions.resize(finestLevel + 1);
 
   if(fileType == Amrvis::FAB) {
     ifstream is;
@@ -917,6 +922,7 @@ bool AmrData::ReadNonPlotfileData(const string &filename, Amrvis::FileType filet
     dataGrids[1].resize(nComp, NULL);
     dataGridsDefined[LevelZero].resize(nComp);
     dataGridsDefined[LevelOne].resize(nComp);
+    dataGridsRegions[LevelOne].resize(nComp);
     fabBoxArray.resize(1);
     fabBoxArray.set(BoxZero, probDomain[LevelZero]);
 
@@ -1007,6 +1013,7 @@ bool AmrData::ReadNonPlotfileData(const string &filename, Amrvis::FileType filet
 			   1, visMF[LevelOne][currentVisMF]->nGrow(),
                            Fab_noallocate);
           dataGridsDefined[LevelOne][iComp].resize(visMF[LevelOne][currentVisMF]->size(), false);
+          dataGridsRegions[LevelOne][iComp].resize(visMF[LevelOne][currentVisMF]->size());
           compIndexToVisMFMap[iComp] = currentVisMF;
           compIndexToVisMFComponentMap[iComp] = currentVisMFComponent;
           ++currentVisMFComponent;
@@ -1700,7 +1707,11 @@ MultiFab &AmrData::GetGrids(int level, int componentIndex, const Box &onBox) {
         mfi.isValid(); ++mfi)
     {
       if(onBox.intersects(visMF[level][whichVisMF]->boxArray()[mfi.index()])) {
-        DefineFab(level, componentIndex, mfi.index());
+        if(selectiveReads) {
+          DefineFabRegion(level, componentIndex, mfi.index(), onBox);
+        } else {
+          DefineFab(level, componentIndex, mfi.index());
+        }
       }
     }
   }
@@ -1714,14 +1725,52 @@ bool AmrData::DefineFab(int level, int componentIndex, int fabIndex) {
   if( ! dataGridsDefined[level][componentIndex][fabIndex]) {
     int whichVisMF(compIndexToVisMFMap[componentIndex]);
     int whichVisMFComponent(compIndexToVisMFComponentMap[componentIndex]);
-    dataGrids[level][componentIndex]->setFab(fabIndex,
-                visMF[level][whichVisMF]->readFAB(fabIndex, whichVisMFComponent));
+    MultiFab &mf = *dataGrids[level][componentIndex];
+    if(mf.defined(fabIndex)) {  // ---- partly read by DefineFabRegion
+      BoxList &regions = dataGridsRegions[level][componentIndex][fabIndex];
+      BoxList unread(amrex::complementIn(mf[fabIndex].box(), regions));
+      for(const Box &b : unread) {
+        visMF[level][whichVisMF]->readFABRegion(fabIndex, mf[fabIndex], b,
+                                                whichVisMFComponent, 0, 1);
+      }
+      regions.clear();
+    } else {
+      mf.setFab(fabIndex, visMF[level][whichVisMF]->readFAB(fabIndex, whichVisMFComponent));
+    }
     dataGridsDefined[level][componentIndex][fabIndex] = true;
   }
   return true;
 }
 
 
+// ---------------------------------------------------------------
+void AmrData::DefineFabRegion(int level, int componentIndex, int fabIndex,
+                              const Box &onBox)
+{
+  if(dataGridsDefined[level][componentIndex][fabIndex]) {
+    return;
+  }
+  int whichVisMF(compIndexToVisMFMap[componentIndex]);
+  int whichVisMFComponent(compIndexToVisMFComponentMap[componentIndex]);
+  MultiFab &mf = *dataGrids[level][componentIndex];
+  if( ! mf.defined(fabIndex)) {
+    mf.setFab(fabIndex, new FArrayBox(mf.fabbox(fabIndex), 1));
+  }
+  BoxList &regions = dataGridsRegions[level][componentIndex][fabIndex];
+  BoxList unread(amrex::complementIn(onBox & mf[fabIndex].box(), regions));
+  for(const Box &b : unread) {
+    visMF[level][whichVisMF]->readFABRegion(fabIndex, mf[fabIndex], b,
+                                            whichVisMFComponent, 0, 1);
+  }
+  regions.join(unread);
+  regions.simplify();
+  if(regions.contains(BoxList(mf[fabIndex].box()))) {
+    regions.clear();
+    dataGridsDefined[level][componentIndex][fabIndex] = true;
+  }
+}
+
+
 // ---------------------------------------------------------------
 void AmrData::FlushGrids(int componentIndex) {
 
@@ -1742,6 +1791,7 @@ void AmrData::FlushGrids(int componentIndex) {
       dataGrids[lev][componentIndex] = new MultiFab(ba, dm, 1, nGrow, Fab_noallocate);
       for(MFIter mfi(*dataGrids[lev][componentIndex]); mfi.isValid(); ++mfi) {
          dataGridsDefined[lev][componentIndex][mfi.index()] = false;
+         dataGridsRegions[lev][componentIndex][mfi.index()].clear();
       }
     }
   }
@@ -912,8 +912,10 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         else
         {
             const Real beta = (rho/rho_1)*(alpha/omega);
-            sxay(p, p, -omega, v);
-            sxay(p, r,   beta, p);
+            //
+            // p = r + beta*(p - omega*v) in one pass.
+            //
+            MultiFab::LinComb(p, 1.0, r, 0, beta, p, 0, -beta*omega, v, 0, 0, 1, 0);
         }
         if ( use_mg_precond )
         {
@@ -939,10 +941,24 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 	{
             ret = 2; break;
 	}
-        sxay(sol, sol,  alpha, ph);
-        sxay(s,     r, -alpha,  v);
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+        sxay(sol, sol, alpha, ph);
+        rnorm = MultiFab::LinCombNorm0(s, 1.0, r, 0, -alpha, v, 0, 0, 1, 0);
+#else
+        //
+        // Update sol and s, getting their max norms from the same passes,
+        // and reduce both norms together.
+        //
+        {
+            Real vals[2] = { MultiFab::LinCombNorm0(s, 1.0, r, 0, -alpha, v, 0, 0, 1, 0, true),
+                             MultiFab::SaxpyNorm0(sol, alpha, ph, 0, 0, 1, 0, true) };
+
+            ParallelDescriptor::ReduceRealMax(vals,2,color());
 
-        rnorm = norm_inf(s);
+            rnorm    = vals[0];
+            sol_norm = vals[1];
+        }
+#endif
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -956,7 +972,6 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( use_mg_precond )
@@ -975,11 +990,11 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         }
         Lp.apply(t, sh, lev, temp_bc_mode);
         //
-        // This is a little funky.  I want to elide one of the reductions
-        // in the following two dotxy()s.  We do that by calculating the "local"
-        // values and then reducing the two local values at the same time.
+        // Compute t.t and t.s in one pass over t and reduce them together.
         //
-        Real vals[2] = { dotxy(t,t,true), dotxy(t,s,true) };
+        Real vals[2];
+
+        MultiFab::Dot2(t, 0, t, 0, s, 0, 1, 0, vals[0], vals[1], true);
 
         ParallelDescriptor::ReduceRealSum(vals,2,color());
 
@@ -991,10 +1006,20 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 	{
             ret = 3; break;
 	}
-        sxay(sol, sol,  omega, sh);
-        sxay(r,     s, -omega,  t);
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
+        sxay(sol, sol, omega, sh);
+        rnorm = MultiFab::LinCombNorm0(r, 1.0, s, 0, -omega, t, 0, 0, 1, 0);
+#else
+        {
+            Real vals[2] = { MultiFab::LinCombNorm0(r, 1.0, s, 0, -omega, t, 0, 0, 1, 0, true),
+                             MultiFab::SaxpyNorm0(sol, omega, sh, 0, 0, 1, 0, true) };
 
-        rnorm = norm_inf(r);
+            ParallelDescriptor::ReduceRealMax(vals,2,color());
+
+            rnorm    = vals[0];
+            sol_norm = vals[1];
+        }
+#endif
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -1008,7 +1033,6 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( omega == 0 )
@@ -0,0 +1,133 @@
+#include <memory>
+
+#include <AMReX_Amr.H>
+#include <AMReX_AmrLevel.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Checks that the state data of a level made with AmrLevel::reuseStateData
+// (amr.incremental_regrid), which takes the FABs of the old level on the
+// boxes it keeps, are those of the plain FillPatch from the old level.
+//
+// Runs the advection tutorial for a few steps.  Then, for every level,
+// keeps every other box of the grids, halves the others, and inits two
+// new levels on these grids from the old one: one reusing the old data,
+// one without.  This is done with the distribution map of makeKeepOwners,
+// where the kept boxes stay and are reused, and with one where every box
+// moves to the next process, so that nothing may be reused.  Run it on 1
+// and on several ranks.
+//
+
+namespace
+{
+    BoxArray
+    halveEveryOther (const BoxArray& ba)
+    {
+        BoxList bl(ba.ixType());
+        for (int i = 0, N = ba.size(); i < N; ++i)
+        {
+            Box b = ba[i];
+            int dir;
+            const int len = b.longside(dir);
+            if (i % 2 == 1 && len % 2 == 0) {
+                bl.push_back(b.chop(dir, b.smallEnd(dir) + len/2));
+            }
+            bl.push_back(b);
+        }
+        return BoxArray(bl);
+    }
+
+    Real
+    maxdiff (const MultiFab& a, const MultiFab& b)
+    {
+        MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), 0);
+        MultiFab::Copy(d, a, 0, 0, a.nComp(), 0);
+        MultiFab::Subtract(d, b, 0, 0, a.nComp(), 0);
+        Real err = 0;
+        for (int n = 0; n < a.nComp(); ++n) {
+            err = std::max(err, d.norm0(n));
+        }
+        return err;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nsteps = 4;
+        {
+            ParmParse pp;
+            pp.query("nsteps", nsteps);
+        }
+
+        Amr amr;
+        amr.init(0.0, -1.0);
+        for (int i = 0; i < nsteps; ++i) {
+            amr.coarseTimeStep(-1.0);
+        }
+
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int nstate = AmrLevel::get_desc_lst().size();
+        bool ok = true;
+        //
+        // The FABs an old level gives away belong to the level that took
+        // them, so those must live as long as the old level is used.
+        //
+        std::vector< std::unique_ptr<AmrLevel> > takers;
+
+        for (int lev = 0; lev <= amr.finestLevel(); ++lev)
+        {
+            AmrLevel& old = amr.getLevel(lev);
+            const BoxArray&            old_ba = old.boxArray();
+            const DistributionMapping& old_dm = old.DistributionMap();
+            const Real time = old.get_state_data(0).curTime();
+
+            const BoxArray new_ba = halveEveryOther(old_ba);
+            int nkept = 0;
+            const DistributionMapping keep_dm =
+                DistributionMapping::makeKeepOwners(new_ba, old_ba, old_dm, &nkept);
+            Array<int> pmap(new_ba.size());
+            for (int i = 0, N = new_ba.size(); i < N; ++i) {
+                pmap[i] = (keep_dm[i] + 1) % nprocs;
+            }
+            const DistributionMapping moved_dm(pmap);
+
+            for (const DistributionMapping* dm : { &keep_dm, &moved_dm })
+            {
+                const bool moved = (dm == &moved_dm);
+                std::unique_ptr<AmrLevel> reused((*getLevelBld())(amr, lev, amr.Geom(lev), new_ba, *dm, time));
+                std::unique_ptr<AmrLevel> filled((*getLevelBld())(amr, lev, amr.Geom(lev), new_ba, *dm, time));
+
+                const int nreused = reused->reuseStateData(old);
+                reused->init(old);
+                filled->init(old);
+
+                Real err = 0;
+                for (int i = 0; i < nstate; ++i) {
+                    err = std::max(err, maxdiff(reused->get_new_data(i), filled->get_new_data(i)));
+                }
+                //
+                // The kept boxes are reused only if they stay on their process.
+                //
+                const int nexpected = (moved && nprocs > 1) ? 0 : nkept;
+                if (err != 0 || nreused != nexpected) ok = false;
+
+                amrex::Print() << "level " << lev << (moved ? ", moved owners" : ", kept owners")
+                               << ": reused " << nreused << " of " << new_ba.size()
+                               << " boxes (expected " << nexpected << ")"
+                               << ", max diff " << err << "\n";
+
+                takers.push_back(std::move(reused));
+            }
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,163 @@
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_AmrMesh.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Compares the grids of AmrMesh::MakeNewGrids with distributed clustering
+// (amr.distributed_clustering = 1) with those of the centralized path.
+// The tags are a spherical shell, which crosses the boxes of all ranks,
+// and a small blob.  Both features move a bit for every regrid.
+//
+// The distributed grids must be disjoint, properly nested and cover every
+// tagged cell.  On one rank every rank sees all the tags, so they must
+// also cover exactly the same cells as the centralized grids.  Run it on
+// 1 and on several ranks.
+//
+
+namespace
+{
+    class TagMesh
+        : public AmrMesh
+    {
+    public:
+        Real shift = 0;
+
+        bool tagged (int lev, const IntVect& iv) const
+        {
+            const Real* dx  = Geom(lev).CellSize();
+            const Real* plo = Geom(lev).ProbLo();
+            Real r2 = 0, b2 = 0;
+            for (int d = 0; d < BL_SPACEDIM; ++d) {
+                const Real x = plo[d] + (iv[d]+0.5)*dx[d];
+                const Real c = (d % 2 == 0) ? 0.8 - shift : 0.2 + shift;
+                r2 += (x - 0.5 - shift)*(x - 0.5 - shift);
+                b2 += (x - c)*(x - c);
+            }
+            return std::abs(std::sqrt(r2) - 0.3) < 1.5*dx[0] || b2 < 0.05*0.05;
+        }
+
+        virtual void ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/) override
+        {
+            for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+            {
+                TagBox& tb = tags[mfi];
+                const Box& bx = mfi.validbox();
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    if (tagged(lev, iv)) tb(iv) = TagBox::SET;
+                }
+            }
+        }
+
+        //
+        // The number of tagged cells of the current level levc grids that
+        // new grids at levc+1 do not cover.
+        //
+        long uncovered (int levc, const BoxArray& new_fine) const
+        {
+            BoxArray cba(new_fine);
+            cba.coarsen(refRatio(levc));
+            const BoxArray& ba = boxArray(levc);
+            const DistributionMapping& dm = DistributionMap(levc);
+            long n = 0;
+            for (int i = 0, N = ba.size(); i < N; ++i)
+            {
+                if (dm[i] != ParallelDescriptor::MyProc()) continue;
+                const Box& bx = ba[i];
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    if (tagged(levc, iv) && ! cba.contains(iv)) ++n;
+                }
+            }
+            ParallelDescriptor::ReduceLongSum(n);
+            return n;
+        }
+
+        void install (int new_finest, const Array<BoxArray>& new_grids)
+        {
+            for (int lev = 1; lev <= new_finest; ++lev) {
+                SetBoxArray(lev, new_grids[lev]);
+                SetDistributionMap(lev, DistributionMapping(new_grids[lev]));
+            }
+            for (int lev = new_finest+1; lev <= finestLevel(); ++lev) {
+                ClearBoxArray(lev);
+                ClearDistributionMap(lev);
+            }
+            SetFinestLevel(new_finest);
+        }
+    };
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nregrids = 3;
+        {
+            ParmParse pp;
+            pp.query("nregrids", nregrids);
+        }
+
+        TagMesh mesh;
+        mesh.SetDistributedClustering(false);
+        mesh.MakeNewGrids(0.0);
+
+        const bool one_rank = (ParallelDescriptor::NProcs() == 1);
+        bool ok = true;
+
+        for (int ir = 0; ir < nregrids; ++ir)
+        {
+            mesh.shift = 0.02*(ir+1);
+
+            int finest_c, finest_d;
+            Array<BoxArray> grids_c(mesh.maxLevel()+1), grids_d(mesh.maxLevel()+1);
+            mesh.SetDistributedClustering(false);
+            mesh.MakeNewGrids(0, 0.0, finest_c, grids_c);
+            mesh.SetDistributedClustering(true);
+            mesh.MakeNewGrids(0, 0.0, finest_d, grids_d);
+
+            if (finest_c != finest_d) {
+                amrex::Print() << "regrid " << ir << ": finest level " << finest_d
+                               << " instead of " << finest_c << "\n";
+                ok = false;
+            }
+
+            for (int lev = 1; lev <= std::min(finest_c, finest_d); ++lev)
+            {
+                const BoxArray& bc = grids_c[lev];
+                const BoxArray& bd = grids_d[lev];
+
+                const bool disjoint = bd.isDisjoint();
+                const long missed   = mesh.uncovered(lev-1, bd);
+                bool nested = true;
+                if (lev > 1) {
+                    BoxArray cba(bd);
+                    cba.coarsen(mesh.refRatio(lev-1));
+                    nested = grids_d[lev-1].contains(cba);
+                }
+                const bool same = bc.contains(bd) && bd.contains(bc);
+
+                if ( ! disjoint || missed > 0 || ! nested || (one_rank && ! same)) {
+                    ok = false;
+                }
+
+                amrex::Print() << "regrid " << ir << " level " << lev
+                               << ": boxes " << bd.size() << " (centralized " << bc.size() << ")"
+                               << ", cells " << bd.numPts() << " (centralized " << bc.numPts() << ")"
+                               << ", tags not covered " << missed
+                               << (disjoint ? "" : ", overlapping")
+                               << (nested ? "" : ", not properly nested")
+                               << (same ? ", same cells" : "") << "\n";
+            }
+
+            mesh.install(finest_c, grids_c);
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,163 @@
+#include <cstring>
+#include <vector>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Checks TagBox::buffer and TagBox::numTags against the loops they
+// replaced: the stencil loop over every SET cell of the interior, and
+// a count of the nonzero cells.  The tags are random SET, BUF and CLEAR
+// cells, also in the boundary region, on boxes whose first direction is
+// shorter than, equal to and longer than the 64 bits of a mask word, for
+// nbuf = 0, 1, 63, 64 and 65.
+//
+
+namespace
+{
+    void
+    bufferRef (TagBox& tb, int nbuff, int nwid)
+    {
+        const Box inside = amrex::grow(tb.box(), -nwid);
+        if (!inside.ok()) return;
+
+        std::vector<IntVect> set;
+        for (IntVect iv = inside.smallEnd(); iv <= inside.bigEnd(); inside.next(iv)) {
+            if (tb(iv) == TagBox::SET) set.push_back(iv);
+        }
+        for (const IntVect& iv : set)
+        {
+            const Box nb = amrex::grow(Box(iv,iv), nbuff);
+            for (IntVect jv = nb.smallEnd(); jv <= nb.bigEnd(); nb.next(jv)) {
+                if (tb(jv) != TagBox::SET) tb(jv) = TagBox::BUF;
+            }
+        }
+    }
+
+    long
+    numTagsRef (const TagBox& tb, const Box& b)
+    {
+        const Box bx = b & tb.box();
+        long n = 0;
+        if (bx.ok()) {
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                if (tb(iv) != TagBox::CLEAR) ++n;
+            }
+        }
+        return n;
+    }
+
+    //
+    // Random tags with about nset SET cells in the interior, which are the
+    // ones buffered, and some in the boundary region, which are not.
+    //
+    void
+    randomTags (TagBox& tb, const Box& interior, long nset)
+    {
+        const Box& bx = tb.box();
+        const double pin  = std::min(0.3, double(nset)/double(interior.numPts()));
+        const double pout = std::min(0.3, double(nset)/double(bx.numPts()));
+        for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+        {
+            const double pset = interior.contains(iv) ? pin : pout;
+            const double r = amrex::Random();
+            tb(iv) = (r < pset) ? TagBox::SET : (r < pset + 0.05) ? TagBox::BUF : TagBox::CLEAR;
+        }
+        //
+        // At least one, so that there is something to buffer.
+        //
+        IntVect iv;
+        for (int d = 0; d < BL_SPACEDIM; ++d) {
+            iv[d] = interior.smallEnd(d) + amrex::Random_int(interior.length(d));
+        }
+        tb(iv) = TagBox::SET;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int seed = 42;
+        {
+            ParmParse pp;
+            pp.query("seed", seed);
+        }
+        amrex::InitRandom(seed);
+
+        const IntVect shapes[] = { IntVect(D_DECL(  1, 1, 1)),
+                                   IntVect(D_DECL(  7, 3, 5)),
+                                   IntVect(D_DECL( 64, 2, 3)),
+                                   IntVect(D_DECL( 65, 9, 4)),
+                                   IntVect(D_DECL(130, 5, 2)),
+                                   IntVect(D_DECL( 33,33, 1)),
+                                   IntVect(D_DECL(200, 1, 1)) };
+        const int nbufs[] = { 0, 1, 63, 64, 65 };
+
+        bool ok = true;
+
+        for (const IntVect& shape : shapes)
+        {
+            for (int nbuf : nbufs)
+            {
+                //
+                // The valid box, not at the origin, grown by nbuf as in
+                // TagBoxArray::buffer.
+                //
+                const IntVect lo(D_DECL(-3, 5, 11));
+                const Box valid(lo, lo + shape - IntVect::TheUnitVector());
+                const Box bx = amrex::grow(valid, nbuf);
+
+                //
+                // Keep the work of the stencil loop bounded.
+                //
+                long stencil = 1;
+                for (int d = 0; d < BL_SPACEDIM; ++d) stencil *= 2*nbuf+1;
+                const long nset = std::max(1L, 20000000L/stencil);
+
+                TagBox tb(bx), ref(bx);
+                randomTags(ref, valid, nset);
+                long nset_valid = 0;
+                for (IntVect iv = valid.smallEnd(); iv <= valid.bigEnd(); valid.next(iv)) {
+                    if (ref(iv) == TagBox::SET) ++nset_valid;
+                }
+                std::memcpy(tb.dataPtr(), ref.dataPtr(), bx.numPts()*sizeof(TagBox::TagType));
+
+                tb.buffer(nbuf, nbuf);
+                bufferRef(ref, nbuf, nbuf);
+
+                long nbad = 0;
+                for (long i = 0, N = bx.numPts(); i < N; ++i) {
+                    if (tb.dataPtr()[i] != ref.dataPtr()[i]) ++nbad;
+                }
+
+                //
+                // numTags of the whole box, of the valid box and of a box
+                // sticking out of it.
+                //
+                const Box sub(valid.smallEnd() + IntVect::TheUnitVector(),
+                              valid.bigEnd() + IntVect(D_DECL(nbuf+7, nbuf+7, nbuf+7)));
+                const bool counts = tb.numTags() == numTagsRef(ref, bx)
+                    && tb.numTags(valid) == numTagsRef(ref, valid)
+                    && tb.numTags(sub) == numTagsRef(ref, sub);
+
+                if (nbad > 0 || !counts) ok = false;
+
+                amrex::Print() << "box " << shape << ", nbuf " << nbuf
+                               << ": SET " << nset_valid << " of " << valid.numPts()
+                               << ", tags after buffer " << tb.numTags() << " of " << bx.numPts()
+                               << ", cells differing " << nbad
+                               << (counts ? "" : ", numTags differs") << "\n";
+            }
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
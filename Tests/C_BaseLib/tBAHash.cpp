@@ -0,0 +1,148 @@
+//
+// Benchmark for the spatial index behind BoxArray::intersections,
+// complementIn and contains.
+//
+// Reads a BoxArray (e.g. ba.95860), optionally chops every other box so
+// that box sizes vary, then times building the index and the queries
+// done when building FillBoundary and ParallelCopy metadata.  A sample
+// of the queries is checked against a brute force search.  Options:
+//
+//   file   = ba.95860   the BoxArray
+//   chop   = 0          if > 0, maxSize(chop) every other box
+//   ngrow  = 1          ghost cells of the FillBoundary like queries
+//   nbuild = 10         number of times the index is built
+//
+
+#include <fstream>
+#include <algorithm>
+
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        std::string file = "ba.95860";
+        int chop   = 0;
+        int ngrow  = 1;
+        int nbuild = 10;
+        {
+            ParmParse pp;
+            pp.query("file", file);
+            pp.query("chop", chop);
+            pp.query("ngrow", ngrow);
+            pp.query("nbuild", nbuild);
+        }
+
+        BoxArray ba;
+        {
+            std::ifstream is(file.c_str(), std::ios::in);
+            if (!is.good()) amrex::FileOpenFailed(file);
+            ba.readFrom(is);
+        }
+
+        if (chop > 0)
+        {
+            BoxList bl;
+            for (int i = 0, N = ba.size(); i < N; ++i)
+            {
+                BoxList tmp(ba[i]);
+                if (i % 2 == 0) tmp.maxSize(chop);
+                bl.join(tmp);
+            }
+            ba = BoxArray(bl);
+        }
+
+        const int N = ba.size();
+        const Box domain = ba.minimalBox();
+
+        amrex::Print() << file << ": " << N << " boxes in " << domain << "\n";
+
+        std::vector< std::pair<int,Box> > isects;
+        //
+        // Building the index.
+        //
+        double t0 = ParallelDescriptor::second();
+        for (int n = 0; n < nbuild; ++n)
+        {
+            ba.clear_hash_bin();
+            ba.intersections(ba[0], isects);
+        }
+        const double t_build = (ParallelDescriptor::second() - t0) / nbuild;
+        //
+        // Queries of FillBoundary: each grown box against the BoxArray.
+        //
+        long nisects = 0;
+        t0 = ParallelDescriptor::second();
+        for (int i = 0; i < N; ++i)
+        {
+            ba.intersections(amrex::grow(ba[i],ngrow), isects);
+            nisects += isects.size();
+        }
+        const double t_fb = ParallelDescriptor::second() - t0;
+        //
+        // Queries of ParallelCopy onto the coarsened BoxArray, and of
+        // building the boundary cells: complementIn of the ghost cells.
+        //
+        BoxArray cba(ba);
+        cba.coarsen(2);
+        long ncisects = 0;
+        t0 = ParallelDescriptor::second();
+        for (int i = 0; i < N; ++i)
+        {
+            cba.intersections(amrex::coarsen(ba[i],2), isects);
+            ncisects += isects.size();
+        }
+        const double t_pc = ParallelDescriptor::second() - t0;
+
+        long ncomp = 0;
+        t0 = ParallelDescriptor::second();
+        for (int i = 0; i < N; ++i)
+        {
+            const BoxList& gcells = amrex::boxDiff(amrex::grow(ba[i],ngrow), ba[i]);
+            for (const Box& b : gcells) {
+                ncomp += ba.complementIn(b).size();
+            }
+        }
+        const double t_comp = ParallelDescriptor::second() - t0;
+
+        t0 = ParallelDescriptor::second();
+        const bool contained = ba.contains(ba);
+        const double t_contains = ParallelDescriptor::second() - t0;
+        //
+        // Check a sample of the queries against a brute force search.
+        //
+        bool ok = contained;
+        for (int i = 0; i < N; i += std::max(1,N/500))
+        {
+            const Box& bx = amrex::grow(ba[i],ngrow);
+            ba.intersections(bx, isects);
+            std::vector<int> found, expected;
+            for (const auto& is : isects) {
+                found.push_back(is.first);
+                if (is.second != (bx & ba[is.first])) ok = false;
+            }
+            for (int j = 0; j < N; ++j) {
+                if (bx.intersects(ba[j])) expected.push_back(j);
+            }
+            std::sort(found.begin(), found.end());
+            if (found != expected) ok = false;
+        }
+
+        amrex::Print() << "build:           " << t_build    << "\n"
+                       << "FB queries:      " << t_fb       << "  (" << nisects  << " intersections)\n"
+                       << "PC queries:      " << t_pc       << "  (" << ncisects << " intersections)\n"
+                       << "complementIn:    " << t_comp     << "  (" << ncomp    << " boxes)\n"
+                       << "contains:        " << t_contains << "\n"
+                       << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
@@ -1,12 +1,25 @@
 
 #include <unistd.h>
 
+#include <AMReX.H>
 #include <AMReX_REAL.H>
+#include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
+#include <AMReX_SArena.H>
 #include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstdint>
 #include <list>
 #include <new>
+#include <random>
+#include <thread>
+#include <vector>
 using std::list;
 
 using namespace amrex;
@@ -64,9 +77,120 @@ FB::ok () const
     return true;
 }
 
+//
+// Emulate regrid/FillPatch churn: keep a pool of live blocks of FAB-like
+// sizes and repeatedly replace a random one.  Returns the elapsed time.
+// Each block is stamped with (seed, slot) so that blocks handed out twice
+// are caught, and must be aligned like Arena::heap_alloc() memory.
+//
+static
+Real
+churn (Arena& arena, int nlive, int nops, int seed = 0)
+{
+    const int sizes[] = { 8*8*8, 16*16*16, 18*18*18, 32*32*32, 34*34*34 };
+    const int nsizes = sizeof(sizes)/sizeof(sizes[0]);
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> pick(0, nlive-1), comps(1, 4);
+
+    std::vector<void*> live(nlive, nullptr);
+
+    auto release = [&] (int k) {
+        if (live[k] && *static_cast<long*>(live[k]) != long(seed)*nlive + k)
+            amrex::Abort("churn: block was handed out twice");
+        arena.free(live[k]);
+    };
+
+    const Real beg = ParallelDescriptor::second();
+
+    for (int i = 0; i < nops; ++i)
+    {
+        const int k = pick(gen);
+        release(k);
+        live[k] = arena.alloc(sizes[i%nsizes]*comps(gen)*sizeof(Real));
+        if (reinterpret_cast<std::uintptr_t>(live[k]) % Arena::align(1) != 0)
+            amrex::Abort("churn: block is not aligned");
+        *static_cast<long*>(live[k]) = long(seed)*nlive + k;
+    }
+
+    for (int k = 0; k < nlive; ++k)
+        release(k);
+
+    return ParallelDescriptor::second() - beg;
+}
+
+static
+void
+benchmark ()
+{
+    const int nlive = 1000;
+    const int nops  = 100000;
+
+    {
+        BArena arena;
+        Real t = churn(arena, nlive, nops);
+        amrex::Print() << "BArena: " << t << " seconds\n";
+    }
+    {
+        CArena arena;
+        Real t = churn(arena, nlive, nops);
+        amrex::Print() << "CArena: " << t << " seconds, heap used "
+                       << arena.heap_space_used() << "\n";
+    }
+    {
+        SArena arena;
+        Real t = churn(arena, nlive, nops);
+        SArena::Stats s = arena.stats();
+        amrex::Print() << "SArena: " << t << " seconds, heap used "
+                       << s.heap_bytes << ", hwm user/block bytes "
+                       << s.user_bytes_hwm << "/" << s.block_bytes_hwm << "\n";
+        //
+        // With everything freed, the free bytes of the classes add up to
+        // all the bytes ever carved.
+        //
+        long free_bytes = 0;
+        for (int cls = 0; cls < SArena::NumClasses; ++cls)
+            free_bytes += arena.freeBytes(cls).first;
+        if (s.block_bytes != 0 || s.user_bytes != 0 || free_bytes != s.free_bytes ||
+            s.free_bytes > s.heap_bytes || s.free_bytes_hwm < s.free_bytes)
+            amrex::Abort("SArena: inconsistent stats");
+        amrex::Print() << "SArena: free bytes " << s.free_bytes
+                       << ", hwm " << s.free_bytes_hwm << "\n";
+    }
+#ifdef _OPENMP
+    {
+        //
+        // All threads allocating from one arena at once.
+        //
+        SArena arena;
+        Real t = 0;
+#pragma omp parallel reduction(max:t)
+        {
+            t = churn(arena, nlive/omp_get_num_threads(), nops/omp_get_num_threads(),
+                      omp_get_thread_num());
+        }
+        amrex::Print() << "SArena with " << omp_get_max_threads() << " threads: "
+                       << t << " seconds\n";
+    }
+#endif
+    {
+        //
+        // A thread that is not one of OpenMP's, like the async I/O thread,
+        // allocating while the main thread does.
+        //
+        SArena arena;
+        std::thread other([&] () { churn(arena, nlive, nops, 1000); });
+        Real t = churn(arena, nlive, nops);
+        other.join();
+        amrex::Print() << "SArena with another thread: " << t << " seconds\n";
+    }
+}
+
 int
-main ()
+main (int argc, char* argv[])
 {
+    amrex::Initialize(argc,argv);
+
     list<FB*> fbl;
 
     for (int j = 0; j < 10; j++)
@@ -85,5 +209,9 @@ main ()
         }
     }
 
+    benchmark();
+
+    amrex::Finalize();
+
     return 0;
 }
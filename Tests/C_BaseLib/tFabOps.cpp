@@ -0,0 +1,220 @@
+//
+// Micro-benchmark for the BaseFab<Real> arithmetic kernels.
+//
+// For each operation and box size this times the Fortran kernels
+// (fort_fab_*) and the C++ SIMD kernels (simd_fab_*), checks that they
+// agree, and reports the memory bandwidth achieved next to that of a
+// STREAM triad.  Options (ParmParse):
+//
+//   sizes = 8 16 32 64 128    box sizes to run
+//   ncomp = 1                 number of components
+//   nwork = 100000000         points touched per (op, size) measurement
+//
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_BaseFab_f.H>
+#include <AMReX_BaseFab_simd.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace
+{
+    Real sink = 0;
+
+    template <class F>
+    double
+    timeit (long nrep, F&& f)
+    {
+        f();  // warm up
+        const double t0 = ParallelDescriptor::second();
+        for (long r = 0; r < nrep; ++r)
+            f();
+        return (ParallelDescriptor::second() - t0) / nrep;
+    }
+
+    double
+    stream_triad (long n)
+    {
+        std::vector<Real> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+        const Real s = 3.0;
+        const int nrep = 10;
+        double best = 1.e30;
+        for (int r = 0; r < nrep; ++r)
+        {
+            const double t0 = ParallelDescriptor::second();
+            Real* pa = a.data(); const Real* pb = b.data(); const Real* pc = c.data();
+            for (long i = 0; i < n; ++i)
+                pa[i] = pb[i] + s*pc[i];
+            best = std::min(best, ParallelDescriptor::second() - t0);
+            sink += a[r];
+        }
+        return 3.0*sizeof(Real)*n / best / 1.e9;
+    }
+
+    Real
+    maxdiff (const FArrayBox& a, const FArrayBox& b)
+    {
+        Real d = 0;
+        const Real* pa = a.dataPtr();
+        const Real* pb = b.dataPtr();
+        for (long i = 0, N = a.size(); i < N; ++i)
+            d = std::max(d, std::abs(pa[i]-pb[i]));
+        return d;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        Array<int> sizes = { 8, 16, 32, 64, 128 };
+        int  ncomp = 1;
+        long nwork = 100000000L;
+        {
+            ParmParse pp;
+            Array<int> sz;
+            if (pp.queryarr("sizes", sz)) sizes = sz;
+            pp.query("ncomp", ncomp);
+            int nw = 0;
+            if (pp.query("nwork", nw)) nwork = nw;
+        }
+
+        const double stream_bw = stream_triad(1L << 25);
+
+        amrex::Print() << "STREAM triad: " << std::setprecision(3) << stream_bw << " GB/s\n\n"
+                       << std::setw(8) << "op" << std::setw(6) << "n"
+                       << std::setw(12) << "fort GB/s" << std::setw(12) << "simd GB/s"
+                       << std::setw(10) << "speedup" << std::setw(12) << "max diff" << "\n";
+
+        for (int n : sizes)
+        {
+            //
+            // The operations act on the interior of fabs with one ghost cell,
+            // as MultiFab operations with nghost = 0 do.
+            //
+            const Box bx(IntVect::TheZeroVector(), IntVect(D_DECL(n-1,n-1,n-1)));
+            const Box gbx = amrex::grow(bx,1);
+            const long npts = bx.numPts() * ncomp;
+            const long nrep = std::max(1L, nwork/npts);
+
+            FArrayBox x(gbx,ncomp), y(gbx,ncomp), z1(gbx,ncomp), z2(gbx,ncomp);
+            FArrayBox one(gbx,ncomp);
+#ifdef BL_USE_SIMD_FAB
+            for (const FArrayBox* fab : { &x, &y, &z1, &z2, &one }) {
+                if (reinterpret_cast<std::uintptr_t>(fab->dataPtr()) % 64 != 0)
+                    amrex::Abort("tFabOps: fab data is not 64 byte aligned");
+            }
+#endif
+            one.setVal(1.0);
+            z1.setVal(0.0);
+            z2.setVal(0.0);
+            for (long i = 0; i < x.size(); ++i) {
+                x.dataPtr()[i] = amrex::Random() + 0.5;
+                y.dataPtr()[i] = amrex::Random() - 0.5;
+            }
+
+            auto report = [&] (const char* name, int nbytes, double tf, double ts, Real diff)
+            {
+                const double bytes = double(nbytes)*sizeof(Real)*npts;
+                amrex::Print() << std::setprecision(3)
+                               << std::setw(8) << name << std::setw(6) << n
+                               << std::setw(12) << bytes/tf/1.e9
+                               << std::setw(12) << bytes/ts/1.e9
+                               << std::setw(10) << tf/ts
+                               << std::setw(12) << diff << "\n";
+            };
+
+            const Real a = 0.75, b = -1.25;
+            double tf, ts;
+
+            // copy
+            tf = timeit(nrep, [&] () {
+                fort_fab_copy(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                              BL_TO_FORTRAN_N_3D(z1,0), BL_TO_FORTRAN_N_3D(x,0),
+                              ARLIM_3D(bx.loVect()), &ncomp); });
+            ts = timeit(nrep, [&] () { simd_fab_copy(z2,bx,0,x,bx,0,ncomp); });
+            report("copy", 2, tf, ts, maxdiff(z1,z2));
+
+            // plus
+            z1.copy(y); z2.copy(y);
+            tf = timeit(nrep, [&] () {
+                fort_fab_plus(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                              BL_TO_FORTRAN_N_3D(z1,0), BL_TO_FORTRAN_N_3D(x,0),
+                              ARLIM_3D(bx.loVect()), &ncomp); });
+            ts = timeit(nrep, [&] () { simd_fab_plus(z2,bx,0,x,bx,0,ncomp); });
+            report("plus", 3, tf, ts, maxdiff(z1,z2));
+
+            // mult
+            z1.copy(y); z2.copy(y);
+            tf = timeit(nrep, [&] () {
+                fort_fab_mult(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                              BL_TO_FORTRAN_N_3D(z1,0), BL_TO_FORTRAN_N_3D(one,0),
+                              ARLIM_3D(bx.loVect()), &ncomp); });
+            ts = timeit(nrep, [&] () { simd_fab_mult(z2,bx,0,one,bx,0,ncomp); });
+            report("mult", 3, tf, ts, maxdiff(z1,z2));
+
+            // saxpy
+            z1.copy(y); z2.copy(y);
+            tf = timeit(nrep, [&] () {
+                fort_fab_saxpy(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                               BL_TO_FORTRAN_N_3D(z1,0), &a, BL_TO_FORTRAN_N_3D(x,0),
+                               ARLIM_3D(bx.loVect()), &ncomp); });
+            ts = timeit(nrep, [&] () { simd_fab_saxpy(z2,bx,0,a,x,bx,0,ncomp); });
+            report("saxpy", 3, tf, ts, maxdiff(z1,z2) / (1.0 + z1.norm(0)));
+
+            // linComb
+            tf = timeit(nrep, [&] () {
+                fort_fab_lincomb(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                 BL_TO_FORTRAN_N_3D(z1,0),
+                                 &a, BL_TO_FORTRAN_N_3D(x,0), ARLIM_3D(bx.loVect()),
+                                 &b, BL_TO_FORTRAN_N_3D(y,0), ARLIM_3D(bx.loVect()),
+                                 &ncomp); });
+            ts = timeit(nrep, [&] () { simd_fab_lincomb(z2,bx,0,a,x,bx,0,b,y,bx,0,ncomp); });
+            report("lincomb", 3, tf, ts, maxdiff(z1,z2));
+
+            // dot
+            Real rf = 0, rs = 0;
+            tf = timeit(nrep, [&] () {
+                rf = fort_fab_dot(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                  BL_TO_FORTRAN_N_3D(x,0), BL_TO_FORTRAN_N_3D(y,0),
+                                  ARLIM_3D(bx.loVect()), &ncomp); });
+            ts = timeit(nrep, [&] () { rs = simd_fab_dot(x,bx,0,y,bx,0,ncomp); });
+            report("dot", 2, tf, ts, std::abs(rf-rs)/std::abs(rf));
+
+            // norm0 and norm1
+            for (int p = 0; p < 2; ++p)
+            {
+                tf = timeit(nrep, [&] () {
+                    rf = fort_fab_norm(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                       BL_TO_FORTRAN_N_3D(y,0), &ncomp, &p); });
+                ts = timeit(nrep, [&] () { rs = simd_fab_norm(y,bx,0,ncomp,p); });
+                report(p == 0 ? "norm0" : "norm1", 1, tf, ts, std::abs(rf-rs)/rf);
+            }
+
+            // sum
+            tf = timeit(nrep, [&] () {
+                rf = fort_fab_sum(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+                                  BL_TO_FORTRAN_N_3D(x,0), &ncomp); });
+            ts = timeit(nrep, [&] () { rs = simd_fab_sum(x,bx,0,ncomp); });
+            report("sum", 1, tf, ts, std::abs(rf-rs)/std::abs(rf));
+
+            amrex::Print() << "\n";
+            sink += z1.sum(0) + z2.sum(0);
+        }
+
+        if (sink == 12345.) amrex::Print() << " ";
+    }
+    amrex::Finalize();
+}
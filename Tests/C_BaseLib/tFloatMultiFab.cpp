@@ -0,0 +1,198 @@
+//
+// A test program for FloatMultiFab.
+//
+// Fills two MultiFabs with random values that are exact in float, copies
+// them into FloatMultiFabs, and checks that Add, Saxpy, LinComb, Dot and
+// norm2 agree with the MultiFab versions within float rounding.  It also
+// checks the conversion to and from MultiFab, FillBoundary across boxes
+// and periodic boundaries, and that a FloatMultiFab written with
+// VisMF::Write reads back into a MultiFab with VisMF::Read.
+//
+
+#include <cmath>
+#include <limits>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_FloatMultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace
+{
+    bool ok = true;
+
+    //
+    // max |a - b| over all components and nghost ghost cells, relative
+    // to max |a|.
+    //
+    Real
+    reldiff (const MultiFab& a, const FloatMultiFab& b, int nghost)
+    {
+        const int ncomp = a.nComp();
+        MultiFab d(a.boxArray(), a.DistributionMap(), ncomp, a.nGrow());
+        FloatMultiFab::Copy(d, b, 0, 0, ncomp, nghost);
+        MultiFab::Subtract(d, a, 0, 0, ncomp, nghost);
+        Real err = 0, mag = 0;
+        for (int n = 0; n < ncomp; ++n) {
+            err = std::max(err, d.norm0(n, nghost));
+            mag = std::max(mag, a.norm0(n, nghost));
+        }
+        return (mag > 0) ? err/mag : err;
+    }
+
+    void
+    check (const std::string& what, Real err, Real tol)
+    {
+        const bool pass = (err <= tol);
+        if (!pass) ok = false;
+        amrex::Print() << what << ": " << err << (pass ? "" : "  <-- too large") << "\n";
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        const int ncomp = 2;
+        const int ngrow = 1;
+        const Real eps = std::numeric_limits<float>::epsilon();
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const Periodicity period(domain.size());
+
+        //
+        // x and y hold values that float represents exactly, so the only
+        // differences below come from the float arithmetic.
+        //
+        MultiFab x(ba,dm,ncomp,ngrow), y(ba,dm,ncomp,ngrow);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& xfab = x[mfi];
+            FArrayBox& yfab = y[mfi];
+            for (long i = 0, N = xfab.size(); i < N; ++i) {
+                xfab.dataPtr()[i] = float(amrex::Random() + 0.5);
+                yfab.dataPtr()[i] = float(amrex::Random() - 0.5);
+            }
+        }
+
+        FloatMultiFab xf(ba,dm,ncomp,ngrow), yf(ba,dm,ncomp,ngrow);
+        FloatMultiFab::Copy(xf, x, 0, 0, ncomp, ngrow);
+        FloatMultiFab::Copy(yf, y, 0, 0, ncomp, ngrow);
+
+        check("MultiFab -> FloatMultiFab -> MultiFab", reldiff(x, xf, ngrow), 0.0);
+        {
+            //
+            // Values that are not exact in float must round to nearest.
+            //
+            MultiFab z(ba,dm,ncomp,ngrow);
+            MultiFab::Copy(z, x, 0, 0, ncomp, ngrow);
+            z.mult(1.0/3.0, 0, ncomp, ngrow);
+            FloatMultiFab zf(ba,dm,ncomp,ngrow);
+            FloatMultiFab::Copy(zf, z, 0, 0, ncomp, ngrow);
+            check("rounding to float", reldiff(z, zf, ngrow), 0.5*eps);
+        }
+
+        const Real a = 0.75, b = -1.25;
+        const Real tol = 4*eps;
+
+        {
+            MultiFab r(ba,dm,ncomp,ngrow);
+            FloatMultiFab rf(ba,dm,ncomp,ngrow);
+            MultiFab::Copy(r, x, 0, 0, ncomp, ngrow);
+            FloatMultiFab::Copy(rf, x, 0, 0, ncomp, ngrow);
+            MultiFab::Add(r, y, 0, 0, ncomp, ngrow);
+            FloatMultiFab::Add(rf, yf, 0, 0, ncomp, ngrow);
+            check("Add", reldiff(r, rf, ngrow), tol);
+        }
+        {
+            MultiFab r(ba,dm,ncomp,ngrow);
+            FloatMultiFab rf(ba,dm,ncomp,ngrow);
+            MultiFab::Copy(r, x, 0, 0, ncomp, ngrow);
+            FloatMultiFab::Copy(rf, x, 0, 0, ncomp, ngrow);
+            MultiFab::Saxpy(r, a, y, 0, 0, ncomp, ngrow);
+            FloatMultiFab::Saxpy(rf, a, yf, 0, 0, ncomp, ngrow);
+            check("Saxpy", reldiff(r, rf, ngrow), tol);
+        }
+        {
+            MultiFab r(ba,dm,ncomp,ngrow);
+            FloatMultiFab rf(ba,dm,ncomp,ngrow);
+            MultiFab::LinComb(r, a, x, 0, b, y, 1, 0, 1, ngrow);
+            FloatMultiFab::LinComb(rf, a, xf, 0, b, yf, 1, 0, 1, ngrow);
+            MultiFab::LinComb(r, a, x, 1, b, y, 0, 1, 1, ngrow);
+            FloatMultiFab::LinComb(rf, a, xf, 1, b, yf, 0, 1, 1, ngrow);
+            check("LinComb", reldiff(r, rf, ngrow), tol);
+        }
+        {
+            const Real d  = MultiFab::Dot(x, 0, y, 1, 1, 0);
+            const Real df = FloatMultiFab::Dot(xf, 0, yf, 1, 1, 0);
+            check("Dot", std::abs(d-df)/std::abs(d), tol);
+            const Real dg  = MultiFab::Dot(x, 0, x, 0, ncomp, ngrow);
+            const Real dgf = FloatMultiFab::Dot(xf, 0, xf, 0, ncomp, ngrow);
+            check("Dot with ghost cells", std::abs(dg-dgf)/dg, tol);
+        }
+        for (int n = 0; n < ncomp; ++n)
+        {
+            const Real nrm  = y.norm2(n);
+            const Real nrmf = yf.norm2(n);
+            check("norm2 of component " + std::to_string(n), std::abs(nrm-nrmf)/nrm, tol);
+        }
+
+        {
+            //
+            // Overwrite the ghost cells and fill them back from the
+            // neighboring boxes and across the periodic boundaries.
+            //
+            MultiFab r(ba,dm,ncomp,ngrow);
+            FloatMultiFab rf(ba,dm,ncomp,ngrow);
+            r.setVal(1.e10);
+            rf.setVal(1.e10f);
+            MultiFab::Copy(r, x, 0, 0, ncomp, 0);
+            FloatMultiFab::Copy(rf, x, 0, 0, ncomp, 0);
+            r.FillBoundary(period);
+            rf.FillBoundary(period);
+            check("FillBoundary", reldiff(r, rf, ngrow), 0.0);
+        }
+
+        {
+            const std::string name("tFloatMultiFab_x");
+            VisMF::Write(xf, name);
+            VisMF::FinishAsyncWrites();
+            MultiFab r;
+            VisMF::Read(r, name);
+            if (r.boxArray() != ba || r.nComp() != ncomp) {
+                amrex::Print() << "VisMF::Read got the wrong layout\n";
+                ok = false;
+            } else {
+                MultiFab xv(ba,r.DistributionMap(),ncomp,0);
+                xv.copy(x, 0, 0, ncomp);
+                MultiFab::Subtract(xv, r, 0, 0, ncomp, 0);
+                Real err = 0;
+                for (int n = 0; n < ncomp; ++n) {
+                    err = std::max(err, xv.norm0(n));
+                }
+                check("VisMF::Write/Read round trip", err, 0.0);
+            }
+            VisMF::RemoveFiles(name);
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
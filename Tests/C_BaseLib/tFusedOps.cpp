@@ -0,0 +1,152 @@
+//
+// A test program for the fused MultiFab operations.
+//
+// Checks the 3-term LinComb, SaxpyNorm0, LinCombNorm0 and Dot2 against
+// the chains of LinComb, Saxpy, norm0 and Dot calls they replace, with
+// the reductions both global (local = false) and per process (local =
+// true), on two components including a ghost cell.
+//
+
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace
+{
+    bool ok = true;
+
+    void
+    check (const std::string& what, Real err, Real tol)
+    {
+        //
+        // With local reductions every process checks its own values.
+        //
+        bool pass = (err <= tol);
+        ParallelDescriptor::ReduceBoolAnd(pass);
+        ParallelDescriptor::ReduceRealMax(err);
+        if (!pass) ok = false;
+        amrex::Print() << what << ": " << err << (pass ? "" : "  <-- too large") << "\n";
+    }
+
+    Real
+    reldiff (Real a, Real b)
+    {
+        return (a != 0) ? std::abs(a-b)/std::abs(a) : std::abs(b);
+    }
+
+    Real
+    maxdiff (const MultiFab& a, const MultiFab& b, int nghost)
+    {
+        MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), nghost);
+        MultiFab::Copy(d, a, 0, 0, a.nComp(), nghost);
+        MultiFab::Subtract(d, b, 0, 0, a.nComp(), nghost);
+        Real err = 0;
+        for (int n = 0; n < a.nComp(); ++n) {
+            err = std::max(err, d.norm0(n, nghost, true));
+        }
+        return err;
+    }
+
+    Real
+    norm0 (const MultiFab& mf, int ncomp, int nghost, bool local)
+    {
+        Real r = 0;
+        for (int n = 0; n < ncomp; ++n) {
+            r = std::max(r, mf.norm0(n, nghost, local));
+        }
+        return r;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        const int ncomp = 2;
+        const int ngrow = 1;
+        const Real tol = 1.e-14;
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab x(ba,dm,ncomp,ngrow), y(ba,dm,ncomp,ngrow), z(ba,dm,ncomp,ngrow);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            for (FArrayBox* fab : { &x[mfi], &y[mfi], &z[mfi] }) {
+                for (long i = 0, N = fab->size(); i < N; ++i) {
+                    fab->dataPtr()[i] = amrex::Random() - 0.5;
+                }
+            }
+        }
+
+        const Real a = 0.75, b = -1.25, c = 0.5;
+
+        MultiFab r1(ba,dm,ncomp,ngrow), r2(ba,dm,ncomp,ngrow);
+
+        //
+        // dst = a*x + b*y + c*z
+        //
+        MultiFab::LinComb(r1, a, x, 0, b, y, 0, c, z, 0, 0, ncomp, ngrow);
+        MultiFab::LinComb(r2, a, x, 0, b, y, 0, 0, ncomp, ngrow);
+        MultiFab::Saxpy(r2, c, z, 0, 0, ncomp, ngrow);
+        check("LinComb with 3 terms", maxdiff(r1, r2, ngrow), tol);
+
+        for (bool local : { false, true })
+        {
+            const std::string how = local ? " (local)" : " (global)";
+
+            //
+            // dst += a*src, then norm0(dst)
+            //
+            MultiFab::Copy(r1, y, 0, 0, ncomp, ngrow);
+            MultiFab::Copy(r2, y, 0, 0, ncomp, ngrow);
+            const Real n1 = MultiFab::SaxpyNorm0(r1, a, x, 0, 0, ncomp, ngrow, local);
+            MultiFab::Saxpy(r2, a, x, 0, 0, ncomp, ngrow);
+            const Real n2 = norm0(r2, ncomp, ngrow, local);
+            check("SaxpyNorm0 data" + how, maxdiff(r1, r2, ngrow), 0.0);
+            check("SaxpyNorm0 norm" + how, reldiff(n2, n1), 0.0);
+
+            //
+            // dst = a*x + b*y, then norm0(dst)
+            //
+            const Real m1 = MultiFab::LinCombNorm0(r1, a, x, 0, b, y, 0, 0, ncomp, ngrow, local);
+            MultiFab::LinComb(r2, a, x, 0, b, y, 0, 0, ncomp, ngrow);
+            const Real m2 = norm0(r2, ncomp, ngrow, local);
+            check("LinCombNorm0 data" + how, maxdiff(r1, r2, ngrow), 0.0);
+            check("LinCombNorm0 norm" + how, reldiff(m2, m1), 0.0);
+
+            //
+            // x.y and x.z in one reduction, with and without ghost cells
+            //
+            for (int ng = 0; ng <= ngrow; ++ng)
+            {
+                Real xy, xz;
+                MultiFab::Dot2(x, 0, y, 0, z, 0, ncomp, ng, xy, xz, local);
+                const Real xy2 = MultiFab::Dot(x, 0, y, 0, ncomp, ng, local);
+                const Real xz2 = MultiFab::Dot(x, 0, z, 0, ncomp, ng, local);
+                check("Dot2 with " + std::to_string(ng) + " ghost cells" + how,
+                      std::max(reldiff(xy2, xy), reldiff(xz2, xz)), tol);
+            }
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
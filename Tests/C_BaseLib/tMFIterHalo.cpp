@@ -0,0 +1,113 @@
+//
+// A test program for the interior-first MFIter, which overlaps
+// FillBoundary with the work on the tiles that do not need ghost cells.
+//
+// Applies a Laplacian with the interior-first MFIter while the
+// FillBoundary is in flight, and checks it against FillBoundary followed
+// by a plain MFIter loop, for 1 and the maximum number of threads.  One
+// of the tile sizes gives no interior tiles at all, and another gives so
+// few that some threads have none.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+static void
+laplacian (const FArrayBox& phi, FArrayBox& lap, const Box& bx)
+{
+    for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+    {
+        Real r = -2.0*BL_SPACEDIM*phi(iv);
+        for (int d = 0; d < BL_SPACEDIM; ++d) {
+            r += phi(iv+BASISV(d)) + phi(iv-BASISV(d));
+        }
+        lap(iv) = r;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell  = 32;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const Periodicity period(domain.size());
+
+        MultiFab phi(ba,dm,1,1), phi_ref(ba,dm,1,1);
+        phi_ref.setVal(0.0);
+        for (MFIter mfi(phi_ref); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = phi_ref[mfi];
+            const Box& bx = mfi.validbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                fab(iv) = amrex::Random() - 0.5;
+            }
+        }
+
+        MultiFab lap(ba,dm,1,0), lap_ref(ba,dm,1,0);
+        phi_ref.FillBoundary(period);
+        for (MFIter mfi(phi_ref); mfi.isValid(); ++mfi) {
+            laplacian(phi_ref[mfi], lap_ref[mfi], mfi.validbox());
+        }
+
+        Array<int> threads(1, 1);
+#ifdef _OPENMP
+        if (omp_get_max_threads() > 1) threads.push_back(omp_get_max_threads());
+#endif
+        const int third = std::max(max_grid_size/3, 1);
+        const IntVect tile_sizes[] = { IntVect(D_DECL(4,4,4)),
+                                       IntVect(D_DECL(third,third,third)),
+                                       IntVect(D_DECL(max_grid_size,max_grid_size,max_grid_size)) };
+
+        bool ok = true;
+        for (int nthreads : threads)
+        {
+#ifdef _OPENMP
+            omp_set_num_threads(nthreads);
+#endif
+            for (const IntVect& tile_size : tile_sizes)
+            {
+                phi.setVal(0.0);
+                MultiFab::Copy(phi, phi_ref, 0, 0, 1, 0);
+                lap.setVal(0.0);
+
+                phi.FillBoundary_nowait(period);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+                for (MFIter mfi(phi, phi, 1, tile_size); mfi.isValid(); ++mfi) {
+                    laplacian(phi[mfi], lap[mfi], mfi.tilebox());
+                }
+
+                MultiFab::Subtract(lap, lap_ref, 0, 0, 1, 0);
+                MultiFab::Subtract(phi, phi_ref, 0, 0, 1, 1);
+                const Real err = std::max(lap.norm0(), phi.norm0(0,1));
+                if (err != 0.0) ok = false;
+                amrex::Print() << "threads " << nthreads << ", tile size " << tile_size
+                               << ": max diff " << err << "\n";
+            }
+        }
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
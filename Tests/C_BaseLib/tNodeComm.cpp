@@ -0,0 +1,162 @@
+//
+// A test program for node aware communication (fabarray.node_aware).
+//
+// Runs FillBoundary and ParallelCopy (COPY and ADD) on MultiFabs in
+// node shared memory (MFInfo().SetNodeShared(true)) and on ordinary ones, checks that they agree and
+// times both.  Use "node.max_size=n" to split a machine into several
+// nodes of n ranks so that the aggregated off-node messages get
+// exercised too.  Needs USE_MPI3=TRUE.
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace
+{
+    void
+    fill (MultiFab& mf)
+    {
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = mf[mfi];
+            const Box& bx = mfi.validbox();
+            fab.setVal(-1.0);
+            for (int n = 0; n < mf.nComp(); ++n) {
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    fab(iv,n) = D_TERM(iv[0], + 1000.*iv[1], + 1.e6*iv[2]) + 0.1*n;
+                }
+            }
+        }
+    }
+
+    Real
+    maxdiff (const MultiFab& a, const MultiFab& b)
+    {
+        MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+        MultiFab::Copy(d, a, 0, 0, a.nComp(), a.nGrow());
+        MultiFab::Subtract(d, b, 0, 0, a.nComp(), a.nGrow());
+        Real r = 0;
+        for (int n = 0; n < a.nComp(); ++n)
+            r = std::max(r, d.norm0(n, a.nGrow()));
+        return r;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int ncomp = 4;
+        int nghost = 2;
+        int nrep = 20;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nghost", nghost);
+            pp.query("nrep", nrep);
+        }
+
+        amrex::Print() << "Ranks: " << ParallelDescriptor::NProcs()
+                       << "  Nodes: " << ParallelDescriptor::NNodes() << "\n";
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        RealBox real_box(D_DECL(0.,0.,0.), D_DECL(1.,1.,1.));
+        int is_per[] = { D_DECL(1,1,1) };
+        Geometry geom(domain, &real_box, 0, is_per);
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        BoxArray ba2(domain);
+        ba2.maxSize(max_grid_size/2);
+        DistributionMapping dm2(ba2);
+
+        const bool node_aware = FabArrayBase::node_aware;
+        FabArrayBase::node_aware = true;
+
+        MultiFab mf_ref(ba,dm,ncomp,nghost), pc_ref(ba2,dm2,ncomp,1);
+
+        const MFInfo node_info = MFInfo().SetNodeShared(true);
+        MultiFab mf_node(ba,dm,ncomp,nghost,node_info), pc_node(ba2,dm2,ncomp,1,node_info);
+
+        //
+        // Only the FabArrays that ask for it get a node shared window.
+        //
+        const bool in_window = ParallelDescriptor::NProcs() > 1;
+        const bool shared_ok = !mf_ref.NodeShared() && !pc_ref.NodeShared() &&
+            mf_node.NodeShared() == in_window && pc_node.NodeShared() == in_window;
+
+        FabArrayBase::node_aware = node_aware;
+
+        bool ok = shared_ok;
+        if (!shared_ok) amrex::Print() << "node shared windows for the wrong FabArrays\n";
+        auto check = [&] (const char* name, const MultiFab& a, const MultiFab& b)
+        {
+            const Real d = maxdiff(a,b);
+            if (d != 0) ok = false;
+            amrex::Print() << name << ": max diff = " << d << "\n";
+        };
+
+        fill(mf_ref);
+        fill(mf_node);
+        mf_ref.FillBoundary(1, ncomp-1, geom.periodicity(), true);
+        mf_node.FillBoundary(1, ncomp-1, geom.periodicity(), true);
+        check("FillBoundary cross", mf_ref, mf_node);
+
+        fill(mf_ref);
+        fill(mf_node);
+        mf_ref.FillBoundary(geom.periodicity());
+        mf_node.FillBoundary(geom.periodicity());
+        check("FillBoundary", mf_ref, mf_node);
+
+        //
+        // The source ghost cells now agree with the valid cells they
+        // overlay, so the result does not depend on the order of copies.
+        //
+        pc_ref.setVal(0.0);
+        pc_node.setVal(0.0);
+        pc_ref.ParallelCopy(mf_ref, 0, 0, ncomp, nghost, 1, geom.periodicity());
+        pc_node.ParallelCopy(mf_node, 0, 0, ncomp, nghost, 1, geom.periodicity());
+        check("ParallelCopy", pc_ref, pc_node);
+
+        pc_ref.ParallelCopy(mf_ref, 0, 0, ncomp, 0, 1, geom.periodicity(), FabArrayBase::ADD);
+        pc_node.ParallelCopy(mf_node, 0, 0, ncomp, 0, 1, geom.periodicity(), FabArrayBase::ADD);
+        check("ParallelCopy ADD", pc_ref, pc_node);
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+
+        Real dt[4];
+        MultiFab* mfs[2] = { &mf_ref, &mf_node };
+        MultiFab* pcs[2] = { &pc_ref, &pc_node };
+        for (int i = 0; i < 2; ++i)
+        {
+            ParallelDescriptor::Barrier();
+            Real t0 = ParallelDescriptor::second();
+            for (int r = 0; r < nrep; ++r)
+                mfs[i]->FillBoundary(geom.periodicity());
+            Real t1 = ParallelDescriptor::second();
+            for (int r = 0; r < nrep; ++r)
+                pcs[i]->ParallelCopy(*mfs[i]);
+            Real t2 = ParallelDescriptor::second();
+            dt[2*i]   = t1-t0;
+            dt[2*i+1] = t2-t1;
+        }
+        ParallelDescriptor::ReduceRealMax(dt,4);
+
+        amrex::Print() << "FillBoundary  default: " << dt[0] << "  node aware: " << dt[2] << "\n"
+                       << "ParallelCopy  default: " << dt[1] << "  node aware: " << dt[3] << "\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,100 @@
+//
+// A test program for ReduceBatch.
+//
+// Checks the batched reductions against the blocking MultiFab ones and
+// times a set of reductions done both ways.
+//
+
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ReduceBatch.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell  = 64;
+        int max_grid_size = 16;
+        int nrep    = 100;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrep", nrep);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab x(ba,dm,2,1), y(ba,dm,2,1);
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& xfab = x[mfi];
+            FArrayBox& yfab = y[mfi];
+            const Box& bx = xfab.box();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                for (int n = 0; n < 2; ++n) {
+                    xfab(iv,n) = amrex::Random() - 0.5;
+                    yfab(iv,n) = amrex::Random() - 0.5;
+                }
+            }
+        }
+
+        const Real ref[] = { x.norm0(0), x.norm1(1), x.norm2(0), x.sum(1),
+                             x.min(0,1), y.max(1,1), MultiFab::Dot(x,0,y,1,1,0) };
+        const char* name[] = { "norm0", "norm1", "norm2", "sum", "min", "max", "Dot" };
+
+        ReduceBatch batch;
+        ReduceBatch::Future f[] = { batch.norm0(x,0), batch.norm1(x,1), batch.norm2(x,0),
+                                    batch.sum(x,1), batch.min(x,0,1), batch.max(y,1,1),
+                                    batch.Dot(x,0,y,1,1,0) };
+        batch.post();
+
+        bool ok = true;
+        for (int i = 0; i < 7; ++i)
+        {
+            const Real v   = f[i].get();
+            const Real err = std::abs(v-ref[i]) / std::max(std::abs(ref[i]), Real(1.e-300));
+            if (err > 1.e-12) ok = false;
+            amrex::Print() << name[i] << ": " << ref[i] << " " << v << "\n";
+        }
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+
+        Real t0 = ParallelDescriptor::second();
+        Real acc0 = 0;
+        for (int r = 0; r < nrep; ++r)
+        {
+            acc0 += x.norm0(0) + x.norm2(1) + MultiFab::Dot(x,0,y,0,1,0) + y.sum(1);
+        }
+        Real t1 = ParallelDescriptor::second();
+        Real acc1 = 0;
+        for (int r = 0; r < nrep; ++r)
+        {
+            ReduceBatch b;
+            ReduceBatch::Future f0 = b.norm0(x,0);
+            ReduceBatch::Future f1 = b.norm2(x,1);
+            ReduceBatch::Future f2 = b.Dot(x,0,y,0,1,0);
+            ReduceBatch::Future f3 = b.sum(y,1);
+            b.post();
+            acc1 += f0.get() + f1.get() + f2.get() + f3.get();
+        }
+        Real t2 = ParallelDescriptor::second();
+
+        Real dt[2] = { t1-t0, t2-t1 };
+        ParallelDescriptor::ReduceRealMax(dt,2);
+
+        amrex::Print() << "blocking: " << dt[0] << "  batched: " << dt[1]
+                       << "  (" << acc0 << " " << acc1 << ")\n";
+    }
+    amrex::Finalize();
+}
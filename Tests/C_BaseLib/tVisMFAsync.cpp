@@ -0,0 +1,109 @@
+//
+// A test program for the asynchronous VisMF::Write (vismf.asyncwrite=1).
+//
+// Writes a MultiFab asynchronously into a temporary directory, asks for
+// the directory to be renamed with VisMF::RenameWhenWritten, as Amr does
+// for plotfiles and checkpoints, and checks that the final name only
+// shows up after VisMF::FinishAsyncWrites.  Then reads the MultiFab back
+// with VisMF::Read and compares it with the original.  The data are
+// changed right after each Write, so staging must have copied them.
+// Options:
+//
+//   n_cell        = 64
+//   max_grid_size = 16
+//   ncomp         = 3
+//   nfiles        = 2     so that ranks take turns in a file
+//   nwrites       = 3     number of write/read rounds
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        int nfiles = 2;
+        int nwrites = 3;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nfiles", nfiles);
+            pp.query("nwrites", nwrites);
+        }
+
+        VisMF::SetAsyncWrite(true);
+        VisMF::SetNOutFiles(nfiles);
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba,dm,ncomp,0), orig(ba,dm,ncomp,0);
+
+        bool ok = true;
+
+        for (int iw = 0; iw < nwrites; ++iw)
+        {
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                FArrayBox& fab = mf[mfi];
+                for (long i = 0, N = fab.size(); i < N; ++i) {
+                    fab.dataPtr()[i] = amrex::Random() + iw;
+                }
+            }
+            MultiFab::Copy(orig, mf, 0, 0, ncomp, 0);
+
+            const std::string dir     = amrex::Concatenate("tVisMFAsync_", iw, 2);
+            const std::string dirTemp = dir + ".temp";
+            //
+            // dir is left empty, which rename() may replace.
+            //
+            amrex::UtilCreateDirectoryDestructive(dir, true);
+            amrex::UtilCreateDirectoryDestructive(dirTemp, true);
+
+            VisMF::Write(mf, dirTemp + "/mf");
+            mf.setVal(-1.0);  // ---- Write must not need mf any more
+
+            VisMF::RenameWhenWritten(dirTemp, dir);
+            ParallelDescriptor::Barrier();
+
+            int early = amrex::FileExists(dir + "/mf_H");
+            ParallelDescriptor::ReduceIntMax(early);
+            if (early) {
+                amrex::Print() << "write " << iw << ": renamed before the data were out\n";
+                ok = false;
+            }
+
+            VisMF::FinishAsyncWrites();
+
+            MultiFab r;
+            VisMF::Read(r, dir + "/mf");
+
+            MultiFab d(ba, r.DistributionMap(), ncomp, 0);
+            d.copy(orig, 0, 0, ncomp);
+            MultiFab::Subtract(d, r, 0, 0, ncomp, 0);
+            Real err = 0;
+            for (int n = 0; n < ncomp; ++n) {
+                err = std::max(err, d.norm0(n));
+            }
+            if (err != 0) ok = false;
+            amrex::Print() << "write " << iw << ": max diff " << err << "\n";
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
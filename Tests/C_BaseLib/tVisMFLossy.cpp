@@ -0,0 +1,150 @@
+//
+// A test program for the lossy compression of VisMF (Compressed_v1 with
+// vismf.compressiontolerance or amr.plot_compression_tolerance > 0).
+//
+// Writes a MultiFab with a few tolerances and reads it back.  Every cell
+// of a FAB stored with Codec_Lossy must be within the tolerance of the
+// original.  One FAB holds a NaN and another a huge dynamic range, which
+// can not be quantized; they must fall back to Codec_Lossless or
+// Codec_None and read back exactly.  Options:
+//
+//   n_cell        = 32
+//   max_grid_size = 16
+//   ncomp         = 2
+//
+
+#include <cmath>
+#include <limits>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        int ncomp = 2;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        if (ba.size() < 3) {
+            amrex::Abort("tVisMFLossy: needs at least 3 boxes");
+        }
+
+        //
+        // A smooth field with some noise.  FAB 0 gets a NaN and FAB 1 a
+        // value too large to be quantized with any of the tolerances.
+        //
+        const int nan_fab = 0, big_fab = 1;
+        MultiFab orig(ba,dm,ncomp,0);
+        for (MFIter mfi(orig); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = orig[mfi];
+            const Box& bx = mfi.validbox();
+            for (int n = 0; n < ncomp; ++n) {
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    fab(iv,n) = std::sin(0.2*iv[0] + n) * std::cos(0.1*iv[1])
+                        + 1.e-3*(amrex::Random() - 0.5);
+                }
+            }
+            if (mfi.index() == nan_fab) {
+                fab(bx.smallEnd(), ncomp-1) = std::numeric_limits<Real>::quiet_NaN();
+            }
+            if (mfi.index() == big_fab) {
+                fab(bx.bigEnd(), 0) = 1.e300;
+            }
+        }
+
+        VisMF::SetHeaderVersion(VisMF::Header::Compressed_v1);
+
+        bool ok = true;
+        const Real tols[] = { 1.e-2, 1.e-5, 1.e-9 };
+
+        for (Real tol : tols)
+        {
+            VisMF::SetCompressionTolerance(tol);
+            const std::string name("tVisMFLossy_mf");
+            VisMF::Write(orig, name);
+            VisMF::FinishAsyncWrites();
+
+            const VisMF vismf(name);
+            MultiFab r;
+            VisMF::Read(r, name);
+            MultiFab o(ba, r.DistributionMap(), ncomp, 0);
+            o.copy(orig, 0, 0, ncomp);
+
+            Real maxerr = 0;
+            int nlossy = 0, nbad = 0, nwrong_codec = 0;
+            for (MFIter mfi(r); mfi.isValid(); ++mfi)
+            {
+                const int idx = mfi.index();
+                const int codec = vismf.codec(idx);
+                const bool lossy = (codec == VisMF::Header::Codec_Lossy);
+                if (lossy) ++nlossy;
+                if (lossy && (idx == nan_fab || idx == big_fab)) ++nwrong_codec;
+
+                const FArrayBox& rfab = r[mfi];
+                const FArrayBox& ofab = o[mfi];
+                const Box& bx = mfi.validbox();
+                for (int n = 0; n < ncomp; ++n) {
+                    for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                        const Real a = ofab(iv,n), b = rfab(iv,n);
+                        if (std::isnan(a) || std::isnan(b)) {
+                            if (!(std::isnan(a) && std::isnan(b))) ++nbad;
+                        } else if (lossy) {
+                            const Real err = std::abs(b - a);
+                            maxerr = std::max(maxerr, err);
+                            if (err > tol) ++nbad;
+                        } else if (a != b) {
+                            ++nbad;
+                        }
+                    }
+                }
+            }
+
+            ParallelDescriptor::ReduceIntSum(nlossy);
+            ParallelDescriptor::ReduceIntSum(nbad);
+            ParallelDescriptor::ReduceIntSum(nwrong_codec);
+            ParallelDescriptor::ReduceRealMax(maxerr);
+
+            //
+            // All but the two special FABs can be quantized.
+            //
+            if (nbad > 0 || nwrong_codec > 0 || nlossy != ba.size() - 2) ok = false;
+
+            amrex::Print() << "tol " << tol << ": " << nlossy << " of " << ba.size()
+                           << " fabs lossy, max error " << maxerr
+                           << ", cells out of bounds " << nbad
+                           << ", special fabs lossy " << nwrong_codec << "\n";
+
+            //
+            // Only the IOProcessor removes the files, so nobody may still be
+            // reading them, nor writing the next ones yet.
+            //
+            ParallelDescriptor::Barrier();
+            VisMF::RemoveFiles(name);
+            ParallelDescriptor::Barrier();
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
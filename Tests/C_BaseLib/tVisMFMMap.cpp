@@ -0,0 +1,159 @@
+//
+// A test program for the memory mapped reads of VisMF (vismf.usemmapreads).
+//
+// Writes a MultiFab with several header versions and reads every fab of
+// this process, whole and by component, with the stream reader and with
+// mmap.  The mapped fabs must match, also after the VisMF that mapped
+// them is destroyed, and changing them must not change the file.  With
+// NoFabHeader_v1 the data must really come from the mapping.  Options:
+//
+//   n_cell        = 32
+//   max_grid_size = 16
+//   ncomp         = 3
+//
+
+#include <memory>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace
+{
+    bool
+    same (const FArrayBox& a, const FArrayBox& b, int acomp, int ncomp)
+    {
+        if (a.box() != b.box() || b.nComp() != ncomp) return false;
+        for (int n = 0; n < ncomp; ++n) {
+            const Real* pa = a.dataPtr(acomp+n);
+            const Real* pb = b.dataPtr(n);
+            for (long i = 0, N = a.box().numPts(); i < N; ++i) {
+                if (pa[i] != pb[i]) return false;
+            }
+        }
+        return true;
+    }
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba,dm,ncomp,1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            FArrayBox& fab = mf[mfi];
+            for (long i = 0, N = fab.size(); i < N; ++i) {
+                fab.dataPtr()[i] = amrex::Random();
+            }
+        }
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::NoFabHeaderMinMax_v1,
+                                                    VisMF::Header::Compressed_v1,
+                                                    VisMF::Header::BinaryIndexed_v1 };
+        bool ok = true;
+
+        for (VisMF::Header::Version vers : versions)
+        {
+            VisMF::SetHeaderVersion(vers);
+            const std::string name("tVisMFMMap_mf");
+            VisMF::Write(mf, name);
+            VisMF::FinishAsyncWrites();
+
+            int nbad = 0, nunmapped = 0;
+
+            //
+            // The reference fabs, read through the stream reader.
+            //
+            VisMF::SetUseMMapReads(false);
+            VisMF ref(name);
+            const Array<int>& myFabs = mf.IndexArray();
+            std::vector< std::unique_ptr<FArrayBox> > refs, whole, parts;
+            for (int idx : myFabs) {
+                refs.emplace_back(ref.readFAB(idx, name));
+            }
+
+            VisMF::SetUseMMapReads(true);
+            {
+                std::unique_ptr<VisMF> mapped(new VisMF(name));
+                for (int i = 0, N = myFabs.size(); i < N; ++i)
+                {
+                    const int idx = myFabs[i];
+                    const FArrayBox& r = *refs[i];
+                    whole.emplace_back(mapped->readFAB(idx, name));
+                    if ( ! same(r, *whole.back(), 0, ncomp)) ++nbad;
+                    for (int n = 0; n < ncomp; ++n) {
+                        parts.emplace_back(mapped->readFAB(idx, n));
+                        if ( ! same(r, *parts.back(), n, 1)) ++nbad;
+                    }
+                    if ( ! same(r, mapped->GetFab(idx, 0), 0, 1)) ++nbad;
+                    //
+                    // Mapped fabs of the same file share its mapping, so
+                    // component 1 directly follows component 0 of the whole fab.
+                    //
+                    const FArrayBox& w = *whole.back();
+                    const FArrayBox& c1 = *parts[parts.size()-ncomp+1];
+                    if (c1.dataPtr() != w.dataPtr() + w.box().numPts()) ++nunmapped;
+                }
+            }
+            VisMF::SetUseMMapReads(false);
+
+            //
+            // The mapping VisMF is gone.  Compare again, then scribble on
+            // the mapped fabs and check that the file is unchanged.
+            //
+            for (int i = 0, N = myFabs.size(); i < N; ++i)
+            {
+                const FArrayBox& r = *refs[i];
+                if ( ! same(r, *whole[i], 0, ncomp)) ++nbad;
+                for (int n = 0; n < ncomp; ++n) {
+                    if ( ! same(r, *parts[i*ncomp+n], n, 1)) ++nbad;
+                }
+                whole[i]->setVal(-1.0);
+                std::unique_ptr<FArrayBox> r2(ref.readFAB(myFabs[i], name));
+                if ( ! same(r, *r2, 0, ncomp)) ++nbad;
+            }
+            whole.clear();
+            parts.clear();
+
+            ParallelDescriptor::ReduceIntSum(nbad);
+            ParallelDescriptor::ReduceIntSum(nunmapped);
+
+            const bool must_map = (vers == VisMF::Header::NoFabHeader_v1);
+            if (nbad > 0 || (must_map && nunmapped > 0)) ok = false;
+
+            amrex::Print() << "version " << vers << ": fabs differing " << nbad
+                           << ", fabs not mapped " << nunmapped
+                           << (must_map ? " (must be 0)" : "") << "\n";
+
+            ParallelDescriptor::Barrier();
+            VisMF::RemoveFiles(name);
+            ParallelDescriptor::Barrier();
+        }
+
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,138 @@
+//
+// Benchmark for VisMF::readFABRegion.
+//
+// Writes a MultiFab, then reads a small box, a slice normal to each
+// direction and one component of every fab, once with readFABRegion
+// and once by reading the whole component with readFAB.  Prints the
+// bytes read from the files and the times, and checks that both agree.
+// Options:
+//
+//   n_cell        = 128   cells in each direction
+//   max_grid_size = 64
+//   ncomp         = 4
+//   region        = 8     size of the small box
+//   nrep          = 3     number of times each read is done
+//
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 64;
+        int ncomp = 4;
+        int region = 8;
+        int nrep = 3;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("region", region);
+            pp.query("nrep", nrep);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        MultiFab mf(ba, dm, ncomp, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = mf[mfi];
+            const Box& bx = fab.box();
+            for (int n = 0; n < ncomp; ++n) {
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    fab(iv,n) = D_TERM(iv[0], + 1000.*iv[1], + 1.e6*iv[2]) + 0.1*n;
+                }
+            }
+        }
+
+        bool ok = true;
+        const char* fmtName[] = { "NATIVE", "IEEE32" };
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1 };
+        for (int fmt = 0; fmt < 2; ++fmt)
+        for (VisMF::Header::Version v : versions)
+        {
+            FArrayBox::setFormat(fmt == 0 ? FABio::FAB_NATIVE : FABio::FAB_IEEE_32);
+            VisMF::SetHeaderVersion(v);
+            VisMF::Write(mf, "tVisMFRegion_mf");
+            ParallelDescriptor::Barrier();
+
+            VisMF vmf("tVisMFRegion_mf");
+            amrex::Print() << "format " << fmtName[fmt] << "  version " << v << "\n";
+
+            for (int shape = 0; shape <= BL_SPACEDIM + 1; ++shape)
+            {
+                long nbRegion = 0, nbWhole = 0;
+                Real tRegion = 0, tWhole = 0, diff = 0;
+                std::string name;
+                for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+                {
+                    const int idx = mfi.index();
+                    const Box& vbx = mfi.validbox();
+                    Box rbx = vbx;
+                    int comp = ncomp/2;
+                    if (shape == 0) {
+                        name = "small box";
+                        const IntVect c = vbx.smallEnd() + (vbx.size() - region)/2;
+                        rbx = Box(c, c + (region-1));
+                    } else if (shape <= BL_SPACEDIM) {
+                        const int d = shape-1;
+                        name = "slice normal to " + std::to_string(d);
+                        const int mid = (vbx.smallEnd(d) + vbx.bigEnd(d))/2;
+                        rbx.setSmall(d, mid);
+                        rbx.setBig(d, mid);
+                    } else {
+                        name = "one component";
+                    }
+                    FArrayBox fr(rbx, 1);
+                    for (int r = 0; r < nrep; ++r) {
+                        Real t0 = ParallelDescriptor::second();
+                        nbRegion += vmf.readFABRegion(idx, fr, rbx, comp, 0, 1);
+                        tRegion += ParallelDescriptor::second() - t0;
+
+                        t0 = ParallelDescriptor::second();
+                        FArrayBox* fw = vmf.readFAB(idx, comp);
+                        tWhole += ParallelDescriptor::second() - t0;
+                        //
+                        // What readFAB reads is what the region read of
+                        // the whole fab reads.
+                        //
+                        nbWhole += vmf.readFABRegion(idx, *fw, fw->box(), comp, 0, 1);
+
+                        for (IntVect iv = rbx.smallEnd(); iv <= rbx.bigEnd(); rbx.next(iv)) {
+                            diff = std::max(diff, std::abs(fr(iv,0) - (*fw)(iv,0)));
+                        }
+                        delete fw;
+                    }
+                }
+                ParallelDescriptor::ReduceLongSum(nbRegion);
+                ParallelDescriptor::ReduceLongSum(nbWhole);
+                ParallelDescriptor::ReduceRealMax(tRegion);
+                ParallelDescriptor::ReduceRealMax(tWhole);
+                ParallelDescriptor::ReduceRealMax(diff);
+                if (diff != 0) ok = false;
+                amrex::Print() << "  " << name << ":  region " << nbRegion << " bytes " << tRegion
+                               << " s,  whole fab " << nbWhole << " bytes " << tWhole
+                               << " s,  max diff " << diff << "\n";
+            }
+        }
+
+        VisMF::RemoveFiles("tVisMFRegion_mf");
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
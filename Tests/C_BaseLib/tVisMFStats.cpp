@@ -0,0 +1,138 @@
+//
+// Test of the VisMF stats file, vismf.writestats.
+//
+// Writes a MultiFab with the stats file for each header version and
+// format, checks the mins, maxes and sums in it, finds the fabs with
+// values in a range both from the stats file and by reading the data,
+// and checks that the checksums match what reads back, and do not
+// after one value is changed.  Options:
+//
+//   n_cell        = 64    cells in each direction
+//   max_grid_size = 16
+//   ncomp         = 3
+//
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(n_cell-1,n_cell-1,n_cell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        MultiFab mf(ba, dm, ncomp, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = mf[mfi];
+            const Box& bx = fab.box();
+            for (int n = 0; n < ncomp; ++n) {
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    fab(iv,n) = D_TERM(iv[0], + 0.5*iv[1], + 0.25*iv[2]) + amrex::Random() + n;
+                }
+            }
+        }
+        const Real lo = 0.4*n_cell, hi = 0.5*n_cell;
+
+        VisMF::SetWriteStats(true);
+
+        bool ok = true;
+        const char* fmtName[] = { "NATIVE", "IEEE32" };
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1,
+                                                    VisMF::Header::BinaryIndexed_v1 };
+        for (int fmt = 0; fmt < 2; ++fmt)
+        for (VisMF::Header::Version v : versions)
+        {
+            FArrayBox::setFormat(fmt == 0 ? FABio::FAB_NATIVE : FABio::FAB_IEEE_32);
+            VisMF::SetHeaderVersion(v);
+            VisMF::Write(mf, "tVisMFStats_mf");
+            ParallelDescriptor::Barrier();
+
+            Array< Array<VisMF::FabStats> > stats;
+            VisMF::ReadStats("tVisMFStats_mf", stats);
+
+            Real diff = 0;
+            Array<int> inRange(mf.size(), 0);
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const Box& vbx = mfi.validbox();
+                const FArrayBox& fab = mf[mfi];
+                for (int n = 0; n < ncomp; ++n) {
+                    const VisMF::FabStats& s = stats[mfi.index()][n];
+                    diff = std::max(diff, std::abs(s.m_min - fab.min(vbx,n)));
+                    diff = std::max(diff, std::abs(s.m_max - fab.max(vbx,n)));
+                    diff = std::max(diff, std::abs(s.m_sum - fab.sum(vbx,n)));
+                }
+                for (IntVect iv = vbx.smallEnd(); iv <= vbx.bigEnd(); vbx.next(iv)) {
+                    if (fab(iv,0) >= lo && fab(iv,0) <= hi) {
+                        inRange[mfi.index()] = 1;
+                        break;
+                    }
+                }
+            }
+            ParallelDescriptor::ReduceIntSum(inRange.dataPtr(), inRange.size());
+
+            Real t0 = ParallelDescriptor::second();
+            Array<int> found = VisMF::FabsInRange("tVisMFStats_mf", 0, lo, hi);
+            Real tStats = ParallelDescriptor::second() - t0;
+
+            t0 = ParallelDescriptor::second();
+            MultiFab rmf;
+            VisMF::Read(rmf, "tVisMFStats_mf");
+            Real tRead = ParallelDescriptor::second() - t0;
+
+            const int nFound = found.size();
+            int nMissed = 0;
+            for (int i = 0; i < inRange.size(); ++i) {
+                if (inRange[i] && std::find(found.begin(), found.end(), i) == found.end()) {
+                    ++nMissed;
+                }
+            }
+
+            const long nBad = VisMF::CheckStats(rmf, "tVisMFStats_mf");
+            for (MFIter mfi(rmf); mfi.isValid(); ++mfi) {
+                if (mfi.index() == 0) {
+                    const Box& vbx = mfi.validbox();
+                    rmf[mfi](vbx.smallEnd(), 0) += 1.0;
+                }
+            }
+            const long nChanged = VisMF::CheckStats(rmf, "tVisMFStats_mf");
+
+            ParallelDescriptor::ReduceRealMax(diff);
+            if (diff > 1.e-12*n_cell*std::pow(max_grid_size,BL_SPACEDIM) || nMissed != 0 ||
+                nBad != 0 || nChanged != 1)
+            {
+                ok = false;
+            }
+            amrex::Print() << "format " << fmtName[fmt] << "  version " << v
+                           << ":  stats diff " << diff
+                           << ",  fabs in range " << nFound << " missed " << nMissed
+                           << " in " << tStats << " s, read all " << tRead << " s"
+                           << ",  bad checksums " << nBad << " after change " << nChanged << "\n";
+        }
+
+        VisMF::RemoveFiles("tVisMFStats_mf");
+        amrex::Print() << (ok ? "PASSED" : "FAILED") << "\n";
+    }
+    amrex::Finalize();
+}
@@ -131,27 +131,44 @@ main (int argc, char* argv[])
 
     Real err = 0.0;
 
-    ParallelDescriptor::Barrier();
-    Real wt0 = ParallelDescriptor::second();
+    auto fill_boundary_time = [&] () -> Real
+    {
+        ParallelDescriptor::Barrier();
+        Real wt0 = ParallelDescriptor::second();
+
+        for (int iround = 0; iround < nrounds; ++iround) {
+            for (int c=0; c<2; ++c) {
+                for (int lev = 0; lev < nlevels; ++lev) {
+                    mfs[lev]->FillBoundary_nowait(true);
+                    mfs[lev]->FillBoundary_finish();
+                }
+                for (int lev = nlevels-1; lev >= 0; --lev) {
+                    mfs[lev]->FillBoundary_nowait(true);
+                    mfs[lev]->FillBoundary_finish();
+                }
+            }
+            Real e = double(iround+ParallelDescriptor::MyProc());
+            ParallelDescriptor::ReduceRealMax(e);
+            err += e;
+        }
+
+        ParallelDescriptor::Barrier();
+        Real wt1 = ParallelDescriptor::second();
+        return wt1-wt0;
+    };
 
-    for (int iround = 0; iround < nrounds; ++iround) {
-	for (int c=0; c<2; ++c) {
-	    for (int lev = 0; lev < nlevels; ++lev) {
-		mfs[lev]->FillBoundary_nowait(true);
-		mfs[lev]->FillBoundary_finish();
-	    }
-	    for (int lev = nlevels-1; lev >= 0; --lev) {
-		mfs[lev]->FillBoundary_nowait(true);
-		mfs[lev]->FillBoundary_finish();
-	    }
-	}
-	Real e = double(iround+ParallelDescriptor::MyProc());
-	ParallelDescriptor::ReduceRealMax(e);
-	err += e;
-    }
-	    
-    ParallelDescriptor::Barrier();
-    Real wt1 = ParallelDescriptor::second();
+    //
+    // Compare the regular FillBoundary with the one using persistent plans.
+    //
+    const bool use_persistent_fb = FabArrayBase::use_persistent_fb;
+
+    FabArrayBase::use_persistent_fb = false;
+    Real fb_time = fill_boundary_time();
+
+    FabArrayBase::use_persistent_fb = true;
+    Real fb_persistent_time = fill_boundary_time();
+
+    FabArrayBase::use_persistent_fb = use_persistent_fb;
 
     if (ParallelDescriptor::IOProcessor()) {
 #ifdef BL_USE_UPCXX
@@ -163,8 +180,12 @@ main (int argc, char* argv[])
 	    std::cout << "Using MPI" << std::endl;
 	}
 #endif
+	const int ncalls = nrounds*2*2*nlevels;
 	std::cout << "----------------------------------------------" << std::endl;
-	std::cout << "Fill Boundary Time: " << wt1-wt0 << std::endl;
+	std::cout << "Fill Boundary Time: " << fb_time << std::endl;
+	std::cout << "Fill Boundary Time with persistent plans: " << fb_persistent_time << std::endl;
+	std::cout << "Time per call: " << fb_time/ncalls << " vs. "
+		  << fb_persistent_time/ncalls << std::endl;
 	std::cout << "----------------------------------------------" << std::endl;
 	std::cout << "ignore this line " << err << std::endl;
     }
@@ -229,6 +229,9 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
     case VisMF::Header::NoFabHeaderFAMinMax_v1:
       mfName = "TestMFNoFabHeaderFAMinMax";
     break;
+    case VisMF::Header::Compressed_v1:
+      mfName = "TestMFCompressed";
+    break;
     default:
       amrex::Abort("**** Error in TestWriteNFiles:  bad version.");
   }
@@ -275,6 +278,11 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
   }
   double wallTime(ParallelDescriptor::second() - wallTimeStart);
 
+  // ---- with vismf.asyncwrite the data are still going out here
+  double drainTime(ParallelDescriptor::second());
+  VisMF::FinishAsyncWrites();
+  drainTime = ParallelDescriptor::second() - drainTime;
+
   ParallelDescriptor::Barrier("TestWriteNFiles:AfterWrite");
 
   double wallTimeMax(wallTime);
@@ -283,6 +291,7 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
   ParallelDescriptor::ReduceLongSum(totalBytesWritten, ParallelDescriptor::IOProcessorNumber());
   ParallelDescriptor::ReduceRealMin(wallTimeMin, ParallelDescriptor::IOProcessorNumber());
   ParallelDescriptor::ReduceRealMax(wallTimeMax, ParallelDescriptor::IOProcessorNumber());
+  ParallelDescriptor::ReduceRealMax(drainTime, ParallelDescriptor::IOProcessorNumber());
   Real megabytes((static_cast<Real> (totalBytesWritten)) / bytesPerMB);
 
   if(ParallelDescriptor::IOProcessor()) {
@@ -293,6 +302,9 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
     cout << "  Wall clock time       = " << wallTimeMax << " s." << endl;
     cout << "  Min wall clock time   = " << wallTimeMin << " s." << endl;
     cout << "  Max wall clock time   = " << wallTimeMax << " s." << endl;
+    if(VisMF::GetAsyncWrite()) {
+      cout << "  Async drain time      = " << drainTime << " s." << endl;
+    }
     cout << "------------------------------------------" << endl;
   }
 
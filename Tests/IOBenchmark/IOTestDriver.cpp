@@ -425,6 +425,9 @@ int main(int argc, char *argv[]) {
       case 4:
         hVersion = VisMF::Header::NoFabHeaderFAMinMax_v1;
       break;
+      case 5:
+        hVersion = VisMF::Header::Compressed_v1;
+      break;
       default:
         amrex::Abort("**** Error:  bad hVersion.");
       }
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include "AMReX_Particles.H"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+//
+// Times ParticleContainer::AssignCellDensitySingleLevelFort for CIC and TSC,
+// with the tile buffers added to the MultiFab in non-overlapping passes and
+// with atomics, for a range of thread counts.  It reports the scratch memory
+// of the tile buffers next to what a full copy of the fab per thread would
+// take, and checks that the passes give the same result for every thread
+// count and that the mass is conserved.  It then checks the shapes
+// themselves: one particle at the center of each cell must give the same
+// uniform density with TSC as with CIC, and a single particle must spread
+// over its 27 neighbors with the analytic TSC weights.
+//
+
+struct TestParams {
+  int nx;
+  int ny;
+  int nz;
+  int max_grid_size;
+  int nppc;
+  int ncomp;
+  int nsteps;
+  Array<int> threads;
+  bool verbose;
+};
+
+typedef ParticleContainer<1 + BL_SPACEDIM> MyParticleContainer;
+
+void deposit (MyParticleContainer& myPC, MultiFab& rho, int order, int atomic, int nthreads)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nthreads);
+#else
+  (void) nthreads;
+#endif
+  MyParticleContainer::deposit_order  = order;
+  MyParticleContainer::deposit_atomic = atomic;
+  myPC.AssignCellDensitySingleLevelFort(0, rho, 0, 1, 0);
+}
+
+//
+// With one particle at the center of every cell of a periodic domain, CIC
+// puts each particle's mass in its own cell and TSC spreads it as 1/8, 3/4,
+// 1/8 in each direction, so both give the uniform density mass/vol.
+//
+void check_lattice (const TestParams& parms, const Geometry& geom,
+                    const BoxArray& ba, const DistributionMapping& dmap, Real mass)
+{
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+  MyParticleContainer::ParticleInitData pdata = {mass, 1.0, 2.0, 3.0};
+  myPC.InitOnePerCell(0.5, 0.5, 0.5, pdata);
+
+  const Real vol = AMREX_D_TERM(geom.CellSize(0), *geom.CellSize(1), *geom.CellSize(2));
+  const Real rho0 = mass / vol;
+
+  MultiFab cic(ba, dmap, 1, 1);
+  MultiFab tsc(ba, dmap, 1, 1);
+  for (int nthreads : parms.threads)
+  {
+    for (int atomic = 0; atomic <= 1; ++atomic)
+    {
+      deposit(myPC, cic, 1, atomic, nthreads);
+      deposit(myPC, tsc, 2, atomic, nthreads);
+
+      const Real err = std::max({std::abs(cic.min(0) - rho0), std::abs(cic.max(0) - rho0),
+                                 std::abs(tsc.min(0) - rho0), std::abs(tsc.max(0) - rho0)});
+      MultiFab::Subtract(tsc, cic, 0, 0, 1, 0);
+      const Real diff = tsc.norm0(0);
+      if (err > 1.e-12*rho0 || diff > 1.e-12*rho0) {
+        amrex::Abort("Deposition: TSC and CIC differ on a uniform lattice");
+      }
+    }
+  }
+
+  if (ParallelDescriptor::IOProcessor()) {
+    std::cout << "TSC == CIC on a uniform lattice\n";
+  }
+}
+
+//
+// A single particle must give cell iv0 + (a,b,c), for a,b,c in -1..1, the
+// density mass/vol * w(a,xi_x) * w(b,xi_y) * w(c,xi_z), with
+// w(-1) = (0.5-xi)^2/2, w(0) = 0.75-xi^2 and w(1) = (0.5+xi)^2/2, where xi
+// is the particle's offset from the center of iv0 in cells, and nothing
+// elsewhere.  The cell is put at the edge of a grid and of the (periodic)
+// domain so that the weights cross both.
+//
+void check_single_particle (const TestParams& parms, const Geometry& geom,
+                            const BoxArray& ba, const DistributionMapping& dmap, Real mass)
+{
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  const Real* plo = geom.ProbLo();
+  const Real* dx  = geom.CellSize();
+  const Box& domain = geom.Domain();
+
+  const IntVect iv0(AMREX_D_DECL(0, std::min(parms.max_grid_size, parms.ny) - 1, parms.nz/2));
+  const Real frac[3] = {0.3, 0.85, 0.5};
+
+  MyParticleContainer::ParticleType p;
+  p.m_idata.id  = MyParticleContainer::ParticleType::NextID();
+  p.m_idata.cpu = ParallelDescriptor::MyProc();
+  for (int d = 0; d < BL_SPACEDIM; ++d) {
+    p.m_rdata.pos[d] = plo[d] + (iv0[d] + frac[d])*dx[d];
+  }
+  p.m_rdata.arr[BL_SPACEDIM] = mass;
+  for (int i = 1; i < 1 + BL_SPACEDIM; ++i) {
+    p.m_rdata.arr[BL_SPACEDIM + i] = i;
+  }
+
+  //
+  // Hand the particle to the first tile and let Redistribute put it in its place.
+  //
+  for (MFIter mfi = myPC.MakeMFIter(0); mfi.isValid(); ++mfi) {
+    if (mfi.index() == 0 && mfi.LocalTileIndex() == 0) {
+      myPC.GetParticles(0)[std::make_pair(mfi.index(), mfi.LocalTileIndex())].push_back(p);
+    }
+  }
+  myPC.Redistribute();
+  if (myPC.TotalNumberOfParticles() != 1) {
+    amrex::Abort("Deposition: lost the single particle");
+  }
+
+  //
+  // The weights are computed as the deposition does, so they round alike.
+  //
+  Real w[BL_SPACEDIM][3];
+  for (int d = 0; d < BL_SPACEDIM; ++d) {
+    const Real lx = (p.m_rdata.pos[d] - plo[d]) / dx[d];
+    const Real xi = lx - std::floor(lx) - 0.5;
+    w[d][0] = 0.5*(0.5 - xi)*(0.5 - xi);
+    w[d][1] = 0.75 - xi*xi;
+    w[d][2] = 0.5*(0.5 + xi)*(0.5 + xi);
+  }
+
+  const Real vol = AMREX_D_TERM(dx[0], *dx[1], *dx[2]);
+  const Real rho0 = mass / vol;
+
+  MultiFab rho(ba, dmap, 1, 1);
+  for (int nthreads : parms.threads)
+  {
+    for (int atomic = 0; atomic <= 1; ++atomic)
+    {
+      deposit(myPC, rho, 2, atomic, nthreads);
+
+      Real err = 0.0;
+      for (MFIter mfi(rho); mfi.isValid(); ++mfi)
+      {
+        const Box& bx = mfi.validbox();
+        const FArrayBox& fab = rho[mfi];
+        for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+        {
+          Real expected = rho0;
+          for (int d = 0; d < BL_SPACEDIM; ++d) {
+            const int n = domain.length(d);
+            int o = iv[d] - iv0[d];
+            if (o >  n/2) o -= n;
+            if (o < -n/2) o += n;
+            expected = (std::abs(o) <= 1) ? expected * w[d][o+1] : 0.0;
+          }
+          err = std::max(err, std::abs(fab(iv) - expected));
+        }
+      }
+      ParallelDescriptor::ReduceRealMax(err);
+      if (err > 1.e-12*rho0) {
+        amrex::Abort("Deposition: TSC weights of a single particle are wrong");
+      }
+    }
+  }
+
+  if (ParallelDescriptor::IOProcessor()) {
+    std::cout << "TSC weights of a single particle match\n";
+  }
+}
+
+void test_deposition (TestParams& parms)
+{
+  RealBox real_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    real_box.setLo(n, 0.0);
+    real_box.setHi(n, 1.0);
+  }
+
+  IntVect domain_lo(0 , 0, 0); 
+  IntVect domain_hi(parms.nx - 1, parms.ny - 1, parms.nz-1); 
+  const Box domain(domain_lo, domain_hi);
+
+  int is_per[BL_SPACEDIM];
+  for (int i = 0; i < BL_SPACEDIM; i++) 
+    is_per[i] = 1; 
+  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+  BoxArray ba(domain);
+  ba.maxSize(parms.max_grid_size);
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Number of boxes              : " << ba.size() << '\n';
+  }
+
+  DistributionMapping dmap(ba);
+
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  long num_particles = (long) parms.nppc * parms.nx * parms.ny * parms.nz;
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Total number of particles    : " << num_particles << '\n' << '\n';
+  }
+
+  //
+  // InitRandom wants the particles strictly inside the box.
+  //
+  RealBox init_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    init_box.setLo(n, 1.e-10);
+    init_box.setHi(n, 1.0 - 1.e-10);
+  }
+  const Real mass = 10.0;
+  MyParticleContainer::ParticleInitData pdata = {mass, 1.0, 2.0, 3.0};
+  myPC.InitRandom(num_particles, 451, pdata, false, init_box);
+
+  const int ng = 1;
+  MultiFab rho(ba, dmap, parms.ncomp, ng);
+  MultiFab rho_first(ba, dmap, parms.ncomp, ng);
+
+  //
+  // The largest tile buffer and the largest fab, for the memory estimates.
+  //
+  long max_tile_pts = 0, max_fab_pts = 0;
+  for (MFIter mfi(rho, MyParticleContainer::do_tiling ? MyParticleContainer::tile_size
+                                                      : IntVect::TheZeroVector());
+       mfi.isValid(); ++mfi) {
+    max_tile_pts = std::max(max_tile_pts, amrex::grow(mfi.tilebox(), ng).numPts());
+    max_fab_pts  = std::max(max_fab_pts, mfi.fabbox().numPts());
+  }
+  ParallelDescriptor::ReduceLongMax(max_tile_pts);
+  ParallelDescriptor::ReduceLongMax(max_fab_pts);
+
+  const Real vol = AMREX_D_TERM(geom.CellSize(0), *geom.CellSize(1), *geom.CellSize(2));
+
+  for (int order = 1; order <= 2; ++order)
+  {
+    for (int atomic = 0; atomic <= 1; ++atomic)
+    {
+      MyParticleContainer::deposit_order  = order;
+      MyParticleContainer::deposit_atomic = atomic;
+
+      bool first = true;
+      for (int nthreads : parms.threads)
+      {
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+#endif
+        ParallelDescriptor::Barrier();
+        Real t0 = ParallelDescriptor::second();
+        for (int i = 0; i < parms.nsteps; ++i) {
+          myPC.AssignCellDensitySingleLevelFort(0, rho, 0, parms.ncomp, 0);
+        }
+        Real t = (ParallelDescriptor::second() - t0) / parms.nsteps;
+        ParallelDescriptor::ReduceRealMax(t);
+
+        const Real total_mass = rho.sum(0) * vol;
+        if (std::abs(total_mass - mass*num_particles) > 1.e-8*mass*num_particles) {
+          amrex::Abort("Deposition did not conserve the mass");
+        }
+
+        Real diff = 0.0;
+        if (first) {
+          MultiFab::Copy(rho_first, rho, 0, 0, parms.ncomp, 0);
+          first = false;
+        } else {
+          MultiFab::Subtract(rho, rho_first, 0, 0, parms.ncomp, 0);
+          for (int n = 0; n < parms.ncomp; ++n) {
+            diff = std::max(diff, rho.norm0(n));
+          }
+        }
+
+#ifdef _OPENMP
+        const long scratch = MyParticleContainer::do_tiling ?
+          nthreads * max_tile_pts * parms.ncomp * sizeof(Real) : 0;
+#else
+        const long scratch = 0;
+#endif
+        const long copies = nthreads * max_fab_pts * parms.ncomp * sizeof(Real);
+
+        if (ParallelDescriptor::IOProcessor()) {
+          std::cout << (order == 1 ? "CIC" : "TSC") << (atomic ? " atomic " : " passes ")
+                    << "threads " << nthreads << " : " << t << " s, "
+                    << num_particles/t << " particles/s, scratch "
+                    << scratch/(1024.*1024.) << " MB (fab per thread "
+                    << copies/(1024.*1024.) << " MB), max diff from first " << diff << '\n';
+        }
+      }
+    }
+  }
+
+  check_lattice(parms, geom, ba, dmap, mass);
+  check_single_particle(parms, geom, ba, dmap, mass);
+}
+
+int main(int argc, char* argv[])
+{
+  amrex::Initialize(argc,argv);
+  
+  ParmParse pp;
+  
+  TestParams parms;
+  
+  pp.get("nx", parms.nx);
+  pp.get("ny", parms.ny);
+  pp.get("nz", parms.nz);
+  pp.get("max_grid_size", parms.max_grid_size);
+  pp.get("nppc", parms.nppc);
+  if (parms.nppc < 1 && ParallelDescriptor::IOProcessor())
+    amrex::Abort("Must specify at least one particle per cell");
+
+  parms.ncomp = 1;
+  pp.query("ncomp", parms.ncomp);
+  parms.nsteps = 10;
+  pp.query("nsteps", parms.nsteps);
+
+  parms.threads.push_back(1);
+#ifdef _OPENMP
+  if (omp_get_max_threads() > 1) {
+    parms.threads.push_back(omp_get_max_threads());
+  }
+#endif
+  pp.queryarr("threads", parms.threads);
+  
+  parms.verbose = false;
+  pp.query("verbose", parms.verbose);
+  
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << std::endl;
+    std::cout << "Number of particles per cell : ";
+    std::cout << parms.nppc  << std::endl;
+    std::cout << "Size of domain               : ";
+    std::cout << parms.nx << " " << parms.ny << " " << parms.nz << std::endl;
+  }
+  
+  test_deposition(parms);
+  
+  amrex::Finalize();
+}
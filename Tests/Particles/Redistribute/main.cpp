@@ -0,0 +1,288 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include "AMReX_Particles.H"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+//
+// Times ParticleContainer::Redistribute for a range of thread counts.  Each
+// step moves every particle by a random fraction of a cell and then calls
+// Redistribute, so some particles change tile, some change grid and some
+// change rank.  It also times a ParIter loop that visits every tile.
+//
+// With local > 0 the timed Redistribute exchanges with the neighbor ranks
+// only (this needs USE_MPI3).  A copy of the particles then takes the same
+// steps with the global Redistribute, and after every step both must have
+// the same particles, at the same places, on the same rank, level and grid.
+// In step jump_step one particle jumps half the domain, which is farther
+// than local, so Redistribute has to fall back to the global exchange.
+// With many more boxes in x than in y and z, e.g. nx = 256, ny = nz = 16,
+// max_grid_size = 16 on 8 ranks, that jump goes to a rank that is not a
+// neighbor.
+//
+
+struct TestParams {
+  int nx;
+  int ny;
+  int nz;
+  int max_grid_size;
+  int nppc;
+  int nsteps;
+  Real move;
+  int local;
+  int jump_step;
+  Array<int> threads;
+  bool verbose;
+};
+
+typedef ParticleContainer<1 + BL_SPACEDIM> MyParticleContainer;
+
+//
+// A number in [-1,1) that depends only on the particle, the step and the
+// direction, so that two containers holding the same particles move them
+// alike whatever their order.
+//
+Real random_unit (int id, int cpu, int step, int d)
+{
+  std::uint64_t z = (std::uint64_t(std::uint32_t(id)) << 32) ^ std::uint64_t(std::uint32_t(cpu));
+  z += 0x9e3779b97f4a7c15ULL * std::uint64_t(step*BL_SPACEDIM + d + 1);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z =  z ^ (z >> 31);
+  return 2.0*Real(z >> 11)/Real(1ULL << 53) - 1.0;
+}
+
+void move_particles (MyParticleContainer& myPC, const Geometry& geom, Real move, int step, bool jump)
+{
+  const Real* dx = geom.CellSize();
+  const Real  half = 0.5*(geom.ProbHi(0) - geom.ProbLo(0));
+
+  Array<MyParticleContainer::ParticleTileType*> tiles;
+  for (auto& kv : myPC.GetParticles(0)) {
+    tiles.push_back(&kv.second);
+  }
+  const int ntiles = tiles.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < ntiles; ++i) {
+    for (auto& p : tiles[i]->GetArrayOfStructs()) {
+      for (int d = 0; d < BL_SPACEDIM; ++d) {
+        p.m_rdata.pos[d] += move*random_unit(p.id(), p.cpu(), step, d)*dx[d];
+      }
+      if (jump && p.id() == 1) {
+        p.m_rdata.pos[0] += half;
+      }
+    }
+  }
+}
+
+//
+// Sorted (id, cpu, level, grid, position) of the particles of this rank.
+//
+typedef std::tuple<int, int, int, int, Array<Real> > ParticleKey;
+
+std::vector<ParticleKey> particle_keys (const MyParticleContainer& myPC)
+{
+  std::vector<ParticleKey> keys;
+  const auto& plevs = myPC.GetParticles();
+  for (int lev = 0; lev < plevs.size(); ++lev) {
+    for (const auto& kv : plevs[lev]) {
+      for (const auto& p : kv.second.GetArrayOfStructs()) {
+        if (p.id() <= 0) continue;
+        Array<Real> pos(BL_SPACEDIM);
+        for (int d = 0; d < BL_SPACEDIM; ++d) pos[d] = p.m_rdata.pos[d];
+        keys.emplace_back(p.id(), p.cpu(), lev, kv.first.first, pos);
+      }
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+void test_redistribute (TestParams& parms)
+{
+  RealBox real_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    real_box.setLo(n, 0.0);
+    real_box.setHi(n, 1.0);
+  }
+
+  IntVect domain_lo(0 , 0, 0);
+  IntVect domain_hi(parms.nx - 1, parms.ny - 1, parms.nz-1);
+  const Box domain(domain_lo, domain_hi);
+
+  int is_per[BL_SPACEDIM];
+  for (int i = 0; i < BL_SPACEDIM; i++)
+    is_per[i] = 1;
+  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+  BoxArray ba(domain);
+  ba.maxSize(parms.max_grid_size);
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Number of boxes              : " << ba.size() << '\n';
+  }
+
+  DistributionMapping dmap(ba);
+
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  long num_particles = (long) parms.nppc * parms.nx * parms.ny * parms.nz;
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Total number of particles    : " << num_particles << '\n' << '\n';
+  }
+
+  //
+  // InitRandom wants the particles strictly inside the box.
+  //
+  RealBox init_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    init_box.setLo(n, 1.e-10);
+    init_box.setHi(n, 1.0 - 1.e-10);
+  }
+  MyParticleContainer::ParticleInitData pdata = {1.0, 1.0, 2.0, 3.0};
+  myPC.InitRandom(num_particles, 451, pdata, false, init_box);
+
+  //
+  // With local, a copy of the particles for the global Redistribute.
+  //
+  const bool check = (parms.local > 0);
+  MyParticleContainer refPC(geom, dmap, ba);
+  refPC.SetVerbose(false);
+  if (check) {
+    MyParticleContainer::AoS copy;
+    for (const auto& kv : myPC.GetParticles(0)) {
+      for (const auto& p : kv.second.GetArrayOfStructs()) {
+        copy.push_back(p);
+      }
+    }
+    refPC.AddParticlesAtLevel(copy, 0);
+  }
+
+  int step = 0;
+  bool ok = true;
+  for (int nthreads : parms.threads)
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+#endif
+    Real t_redist = 0.0, t_iter = 0.0;
+    for (int i = 0; i < parms.nsteps; ++i, ++step)
+    {
+      const bool jump = check && (step == parms.jump_step);
+      move_particles(myPC, geom, parms.move, step, jump);
+      if (jump) myPC.SetVerbose(2);  // ---- reports the fall back
+      ParallelDescriptor::Barrier();
+      Real t0 = ParallelDescriptor::second();
+      myPC.Redistribute(0, -1, 0, parms.local);
+      t_redist += ParallelDescriptor::second() - t0;
+      myPC.SetVerbose(false);
+
+      t0 = ParallelDescriptor::second();
+      long np = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:np)
+#endif
+      for (ParIter<1 + BL_SPACEDIM> pti(myPC, 0); pti.isValid(); ++pti) {
+        np += pti.numParticles();
+      }
+      t_iter += ParallelDescriptor::second() - t0;
+      if (np != myPC.TotalNumberOfParticles(true, true)) {
+        amrex::Abort("ParIter missed particles");
+      }
+
+      if (check)
+      {
+        move_particles(refPC, geom, parms.move, step, jump);
+        refPC.Redistribute();
+        int differ = (particle_keys(myPC) != particle_keys(refPC));
+        ParallelDescriptor::ReduceIntMax(differ);
+        if (differ) {
+          ok = false;
+          amrex::Print() << "Step " << step << (jump ? " (jump)" : "")
+                         << " : local and global Redistribute differ\n";
+        }
+      }
+    }
+    ParallelDescriptor::ReduceRealMax(t_redist);
+    ParallelDescriptor::ReduceRealMax(t_iter);
+
+    if (myPC.TotalNumberOfParticles() != num_particles) {
+      amrex::Abort("Redistribute lost particles");
+    }
+    if (!myPC.OK()) {
+      amrex::Abort("Redistribute put particles in the wrong place");
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+      std::cout << "Threads " << nthreads << " : " << t_redist/parms.nsteps
+                << " s per Redistribute, "
+                << num_particles*parms.nsteps/t_redist << " particles/s, "
+                << t_iter/parms.nsteps << " s per ParIter loop\n";
+    }
+  }
+
+  if (check) {
+    amrex::Print() << "local = " << parms.local << " against the global Redistribute: "
+                   << (ok ? "PASSED" : "FAILED") << "\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  amrex::Initialize(argc,argv);
+
+  ParmParse pp;
+
+  TestParams parms;
+
+  pp.get("nx", parms.nx);
+  pp.get("ny", parms.ny);
+  pp.get("nz", parms.nz);
+  pp.get("max_grid_size", parms.max_grid_size);
+  pp.get("nppc", parms.nppc);
+  if (parms.nppc < 1 && ParallelDescriptor::IOProcessor())
+    amrex::Abort("Must specify at least one particle per cell");
+
+  parms.nsteps = 10;
+  pp.query("nsteps", parms.nsteps);
+  parms.move = 0.5;
+  pp.query("move", parms.move);
+  parms.local = 0;
+  pp.query("local", parms.local);
+  parms.jump_step = parms.nsteps/2;
+  pp.query("jump_step", parms.jump_step);
+
+#ifdef _OPENMP
+  parms.threads.push_back(omp_get_max_threads());
+#else
+  parms.threads.push_back(1);
+#endif
+  pp.queryarr("threads", parms.threads);
+
+  parms.verbose = false;
+  pp.query("verbose", parms.verbose);
+
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << std::endl;
+    std::cout << "Number of particles per cell : ";
+    std::cout << parms.nppc  << std::endl;
+    std::cout << "Size of domain               : ";
+    std::cout << parms.nx << " " << parms.ny << " " << parms.nz << std::endl;
+  }
+
+  test_redistribute(parms);
+
+  amrex::Finalize();
+}
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <random>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include "AMReX_Particles.H"
+
+using namespace amrex;
+
+//
+// Checks ParticleContainer::SortParticlesByCell.  After a sort the particles
+// of each tile from CellOffsets()[i] to CellOffsets()[i+1]-1 must all be in
+// cell i of CellBox(), and the array data must have moved with the struct
+// data.  Moving the particles, or calling Redistribute, must drop the
+// offsets again.
+//
+
+struct TestParams {
+  int nx;
+  int ny;
+  int nz;
+  int max_grid_size;
+  int nppc;
+  int nsteps;
+  Real move;
+  bool verbose;
+};
+
+typedef ParticleContainer<1 + BL_SPACEDIM, 0, 1, 1> MyParticleContainer;
+
+//
+// Tag the array data of each particle with its id and cpu, so that we can
+// tell whether it still belongs to the struct data next to it.
+//
+void tag_particles (MyParticleContainer& myPC)
+{
+  for (ParIter<1 + BL_SPACEDIM, 0, 1, 1> pti(myPC, 0); pti.isValid(); ++pti) {
+    auto& aos = pti.GetArrayOfStructs();
+    auto& soa = pti.GetStructOfArrays();
+    for (int i = 0; i < aos.numParticles(); ++i) {
+      soa.GetRealData(0)[i] = aos[i].m_idata.id;
+      soa.GetIntData(0)[i]  = aos[i].m_idata.cpu;
+    }
+  }
+}
+
+void move_particles (MyParticleContainer& myPC, const Geometry& geom, Real move, int step)
+{
+  const Real* dx = geom.CellSize();
+  std::mt19937 gen(1000003*step + 1009*ParallelDescriptor::MyProc());
+  std::uniform_real_distribution<Real> dist(-move, move);
+
+  for (ParIter<1 + BL_SPACEDIM, 0, 1, 1> pti(myPC, 0); pti.isValid(); ++pti) {
+    for (auto& p : pti.GetArrayOfStructs()) {
+      for (int d = 0; d < BL_SPACEDIM; ++d) {
+        p.m_rdata.pos[d] += dist(gen)*dx[d];
+      }
+    }
+  }
+}
+
+//
+// The number of tiles with particles that are (or are not, if sorted is
+// false) sorted by cell, summed over all ranks.
+//
+long count_sorted_tiles (const MyParticleContainer& myPC, bool sorted)
+{
+  long ntiles = 0;
+  for (ParConstIter<1 + BL_SPACEDIM, 0, 1, 1> pti(myPC, 0); pti.isValid(); ++pti) {
+    if (pti.numParticles() > 0 && pti.GetParticleTile().isSortedByCell() == sorted) {
+      ++ntiles;
+    }
+  }
+  ParallelDescriptor::ReduceLongSum(ntiles);
+  return ntiles;
+}
+
+void check_sorted (const MyParticleContainer& myPC, const std::string& when)
+{
+  for (ParConstIter<1 + BL_SPACEDIM, 0, 1, 1> pti(myPC, 0); pti.isValid(); ++pti)
+  {
+    const auto& ptile = pti.GetParticleTile();
+    const auto& aos = ptile.GetArrayOfStructs();
+    const auto& soa = ptile.GetStructOfArrays();
+    const int np = aos.numParticles();
+
+    if (!ptile.isSortedByCell()) {
+      amrex::Abort("SortByCell: tile not sorted " + when);
+    }
+
+    const Box& bx = ptile.CellBox();
+    const Array<int>& offsets = ptile.CellOffsets();
+    const int ncells = bx.numPts();
+
+    if (offsets[0] != 0 || offsets[ncells+1] != np) {
+      amrex::Abort("SortByCell: offsets do not cover the tile " + when);
+    }
+
+    for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+    {
+      const int c = bx.index(iv);
+      if (offsets[c] > offsets[c+1]) {
+        amrex::Abort("SortByCell: offsets out of order " + when);
+      }
+      for (int i = offsets[c]; i < offsets[c+1]; ++i) {
+        if (myPC.Index(aos[i], 0) != iv) {
+          amrex::Abort("SortByCell: particle in the wrong cell " + when);
+        }
+      }
+    }
+    for (int i = offsets[ncells]; i < np; ++i) {
+      if (bx.contains(myPC.Index(aos[i], 0))) {
+        amrex::Abort("SortByCell: particle in the tile box counted outside it " + when);
+      }
+    }
+
+    for (int i = 0; i < np; ++i) {
+      if (soa.GetRealData(0)[i] != aos[i].m_idata.id ||
+          soa.GetIntData(0)[i]  != aos[i].m_idata.cpu) {
+        amrex::Abort("SortByCell: array data did not move with the particles " + when);
+      }
+    }
+  }
+}
+
+void test_sort_by_cell (TestParams& parms)
+{
+  RealBox real_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    real_box.setLo(n, 0.0);
+    real_box.setHi(n, 1.0);
+  }
+
+  IntVect domain_lo(0 , 0, 0);
+  IntVect domain_hi(parms.nx - 1, parms.ny - 1, parms.nz-1);
+  const Box domain(domain_lo, domain_hi);
+
+  int is_per[BL_SPACEDIM];
+  for (int i = 0; i < BL_SPACEDIM; i++)
+    is_per[i] = 1;
+  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+  BoxArray ba(domain);
+  ba.maxSize(parms.max_grid_size);
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Number of boxes              : " << ba.size() << '\n';
+  }
+
+  DistributionMapping dmap(ba);
+
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  long num_particles = (long) parms.nppc * parms.nx * parms.ny * parms.nz;
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << "Total number of particles    : " << num_particles << '\n' << '\n';
+  }
+
+  //
+  // InitRandom wants the particles strictly inside the box.
+  //
+  RealBox init_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    init_box.setLo(n, 1.e-10);
+    init_box.setHi(n, 1.0 - 1.e-10);
+  }
+  MyParticleContainer::ParticleInitData pdata = {{1.0, 1.0, 2.0, 3.0}, {}, {0.0}, {0}};
+  myPC.InitRandom(num_particles, 451, pdata, false, init_box);
+  tag_particles(myPC);
+
+  for (int step = 0; step < parms.nsteps; ++step)
+  {
+    myPC.SortParticlesByCell();
+    check_sorted(myPC, "after SortParticlesByCell");
+
+    //
+    // Sorting again must find nothing to do and keep the offsets.
+    //
+    myPC.SortParticlesByCell(0, -1, 0.5);
+    check_sorted(myPC, "after a second SortParticlesByCell");
+
+    move_particles(myPC, geom, parms.move, step);
+    if (count_sorted_tiles(myPC, true) != 0) {
+      amrex::Abort("SortByCell: moving the particles kept the cell offsets");
+    }
+
+    myPC.SortParticlesByCell();
+    check_sorted(myPC, "after moving the particles");
+
+    //
+    // Redistribute moves particles between tiles and ranks, possibly
+    // without changing how many a tile holds.
+    //
+    move_particles(myPC, geom, parms.move, step + parms.nsteps);
+    myPC.SortParticlesByCell();
+    myPC.Redistribute();
+    if (count_sorted_tiles(myPC, true) != 0) {
+      amrex::Abort("SortByCell: Redistribute kept the cell offsets");
+    }
+
+    if (myPC.TotalNumberOfParticles() != num_particles) {
+      amrex::Abort("SortByCell: lost particles");
+    }
+    if (!myPC.OK()) {
+      amrex::Abort("SortByCell: particles in the wrong place");
+    }
+  }
+
+  if (ParallelDescriptor::IOProcessor()) {
+    std::cout << "SortByCell passed " << parms.nsteps << " steps\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  amrex::Initialize(argc,argv);
+
+  ParmParse pp;
+
+  TestParams parms;
+
+  pp.get("nx", parms.nx);
+  pp.get("ny", parms.ny);
+  pp.get("nz", parms.nz);
+  pp.get("max_grid_size", parms.max_grid_size);
+  pp.get("nppc", parms.nppc);
+  if (parms.nppc < 1 && ParallelDescriptor::IOProcessor())
+    amrex::Abort("Must specify at least one particle per cell");
+
+  parms.nsteps = 4;
+  pp.query("nsteps", parms.nsteps);
+  parms.move = 0.5;
+  pp.query("move", parms.move);
+
+  parms.verbose = false;
+  pp.query("verbose", parms.verbose);
+
+  if (parms.verbose && ParallelDescriptor::IOProcessor()) {
+    std::cout << std::endl;
+    std::cout << "Number of particles per cell : ";
+    std::cout << parms.nppc  << std::endl;
+    std::cout << "Size of domain               : ";
+    std::cout << parms.nx << " " << parms.ny << " " << parms.nz << std::endl;
+  }
+
+  test_sort_by_cell(parms);
+
+  amrex::Finalize();
+}
@@ -74,6 +74,7 @@ set (AMREX_GNU_CXXFLAGS_DEBUG "-g -O0 -fno-inline -ggdb -Wall -Wno-sign-compare"
 set (AMREX_GNU_CXXFLAGS_RELEASE "-O3 -DNDEBUG")
 set (AMREX_GNU_CXXFLAGS_REQUIRED "") #-ftemplate-depth-64 -Wno-deprecated")
 set (AMREX_GNU_CXXFLAGS_FPE "-ftrapv")
+set (AMREX_GNU_CXXFLAGS_SIMD "-fopenmp-simd")
 
 # Intel compiler specific flags
 set (AMREX_Intel_FFLAGS_DEBUG "-g -O0 -traceback -check bounds,uninit,pointers")
@@ -85,6 +86,7 @@ set (AMREX_Intel_CXXFLAGS_DEBUG "-g -O0 -traceback -Wcheck")
 set (AMREX_Intel_CXXFLAGS_RELEASE "-O2 -ip -qopt-report=5 -qopt-report-phase=vec")
 set (AMREX_Intel_CXXFLAGS_REQUIRED "-std=c++11" )#-ftemplate-depth-64 -Wno-deprecated")
 set (AMREX_Intel_CXXFLAGS_FPE "")
+set (AMREX_Intel_CXXFLAGS_SIMD "-qopenmp-simd")
 
 # PGI compiler specific flags
 set (AMREX_PGI_FFLAGS_DEBUG "-O0 -Mbounds -Ktrap=divz,inv -Mchkptr")
@@ -96,6 +98,7 @@ set (AMREX_PGI_CXXFLAGS_DEBUG "-O0 -Mbounds")
 set (AMREX_PGI_CXXFLAGS_RELEASE "-gopt -fast")
 set (AMREX_PGI_CXXFLAGS_REQUIRED "")#-ftemplate-depth-64 -Wno-deprecated")
 set (AMREX_PGI_CXXFLAGS_FPE "")
+set (AMREX_PGI_CXXFLAGS_SIMD "")
 
 # Cray compiler specific flags
 set (AMREX_Cray_FFLAGS_DEBUG "-O0 -e -i")
@@ -107,6 +110,7 @@ set (AMREX_Cray_CXXFLAGS_DEBUG "-O0")
 set (AMREX_Cray_CXXFLAGS_RELEASE "-02")
 set (AMREX_Cray_CXXFLAGS_REQUIRED "")#-ftemplate-depth-64 -Wno-deprecated")
 set (AMREX_Cray_CXXFLAGS_FPE "")
+set (AMREX_Cray_CXXFLAGS_SIMD "")
 
 
 # For Fortran, always use the following preprocessor definitions
@@ -85,6 +85,8 @@ add_define (BL_TINY_PROFILING AMREX_DEFINES ENABLE_TINY_PROFILING)
 add_define (AMREX_TINY_PROFILING AMREX_DEFINES ENABLE_TINY_PROFILING)
 add_define (BL_COMM_PROFILING AMREX_DEFINES ENABLE_COMM_PROFILING)
 add_define (AMREX_COMM_PROFILING AMREX_DEFINES ENABLE_COMM_PROFILING)
+add_define (BL_USE_SIMD_FAB AMREX_DEFINES ENABLE_SIMD_FAB)
+add_define (AMREX_USE_SIMD_FAB AMREX_DEFINES ENABLE_SIMD_FAB)
 
 if ( ENABLE_PARTICLES AND ( NOT ENABLE_DP_PARTICLES ) ) 
    add_define ( BL_SINGLE_PRECISION_PARTICLES AMREX_DEFINES )
@@ -155,6 +157,10 @@ if (ENABLE_OMP)
    append ( OpenMP_CXX_FLAGS AMREX_EXTRA_CXX_FLAGS )
 endif()
 
+# The I/O thread of asynchronous VisMF writes
+find_package (Threads REQUIRED)
+list (APPEND AMREX_EXTRA_CXX_LINK_LINE "${CMAKE_THREAD_LIBS_INIT}")
+
 
 # ------------------------------------------------------------- #
 #    Setup compiler flags 
@@ -186,6 +192,11 @@ if (ENABLE_FPE)
    append ( AMREX_${CXX_ID}_CXXFLAGS_FPE AMREX_CXX_FLAGS )
 endif ()
 
+# Honor "omp simd" in the BaseFab kernels even without OpenMP
+if (ENABLE_SIMD_FAB)
+   append ( AMREX_${CXX_ID}_CXXFLAGS_SIMD AMREX_CXX_FLAGS )
+endif ()
+
 # Set CMake compiler flags
 set ( CMAKE_Fortran_FLAGS_${AMREX_BUILD_TYPE}
    "${AMREX_Fortran_FLAGS}  ${AMREX_Fortran_DEFINITIONS}" ) 
@@ -92,6 +92,9 @@ check_option_value ( "ENABLE_BACKTRACE" ${ENABLE_BACKTRACE} 0 1 )
 
 set (ENABLE_FPE 0 CACHE INT "Enable Floating Point Exceptions checks")
 check_option_value ( "ENABLE_FPE" ${ENABLE_FPE} 0 1 )
+
+set (ENABLE_SIMD_FAB 0 CACHE INT "Use the C++ SIMD kernels for BaseFab<Real> arithmetic")
+check_option_value ( "ENABLE_SIMD_FAB" ${ENABLE_SIMD_FAB} 0 1 )
    
 set (AMREX_FFLAGS_OVERRIDES "" CACHE STRING "User-defined Fortran compiler flags" )
 
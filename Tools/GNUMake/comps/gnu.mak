@@ -79,6 +79,10 @@ ifeq ($(USE_OMP),TRUE)
   GENERIC_COMP_FLAGS += -fopenmp
 endif
 
+ifeq ($(USE_SIMD_FAB),TRUE)
+  CXXFLAGS += -fopenmp-simd
+endif
+
 CXXFLAGS += $(GENERIC_COMP_FLAGS)
 CFLAGS   += $(GENERIC_COMP_FLAGS)
 FFLAGS   += $(GENERIC_COMP_FLAGS)
@@ -59,6 +59,10 @@ ifeq ($(USE_OMP),TRUE)
   endif
 endif
 
+ifeq ($(USE_SIMD_FAB),TRUE)
+  CXXFLAGS += -qopenmp-simd
+endif
+
 CXXFLAGS += $(GENERIC_COMP_FLAGS)
 CFLAGS   += $(GENERIC_COMP_FLAGS)
 FFLAGS   += $(GENERIC_COMP_FLAGS)
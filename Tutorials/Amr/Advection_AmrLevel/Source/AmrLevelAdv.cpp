@@ -287,6 +287,9 @@ AmrLevelAdv::advance (Real time,
 
 	for (MFIter mfi(S_new, true); mfi.isValid(); ++mfi)
 	{
+	    // Measure the cost of the tile for amr.loadbalance_with_cost.
+	    MFCostTimer timer(mfi, getCost());
+
 	    const Box& bx = mfi.tilebox();
 
 	    const FArrayBox& statein = Sborder[mfi];
@@ -8,13 +8,6 @@ void advance (MultiFab& old_phi, MultiFab& new_phi,
 	      std::array<MultiFab, AMREX_SPACEDIM>& flux,
 	      Real dt, const Geometry& geom)
 {
-    // Fill the ghost cells of each grid from the other grids
-    // includes periodic domain boundaries
-    old_phi.FillBoundary(geom.periodicity());
-
-    // Fill non-periodic physical boundaries
-    fill_physbc(old_phi, geom);
-
     int Ncomp = old_phi.nComp();
     int ng_p = old_phi.nGrow();
     int ng_f = flux[0].nGrow();
@@ -27,11 +20,8 @@ void advance (MultiFab& old_phi, MultiFab& new_phi,
     // and we do not have to use flux MultiFab.
     // 
 
-    // Compute fluxes one grid at a time
-    for ( MFIter mfi(old_phi); mfi.isValid(); ++mfi )
+    auto flux_on = [&] (const MFIter& mfi, const Box& bx)
     {
-        const Box& bx = mfi.validbox();
-
         compute_flux(BL_TO_FORTRAN_BOX(bx),
                      BL_TO_FORTRAN_ANYD(old_phi[mfi]),
                      BL_TO_FORTRAN_ANYD(flux[0][mfi]),
@@ -40,6 +30,36 @@ void advance (MultiFab& old_phi, MultiFab& new_phi,
                      BL_TO_FORTRAN_ANYD(flux[2][mfi]),
 #endif
                      dx);
+    };
+
+    if (Geometry::isAllPeriodic())
+    {
+        // Fill the ghost cells of each grid from the other grids,
+        // including periodic domain boundaries.  There are no physical
+        // boundaries, so the fluxes of the tiles that don't need ghost
+        // cells are computed while the messages are in flight.  The
+        // MFIter finishes the FillBoundary before it gets to the others.
+        old_phi.FillBoundary_nowait(geom.periodicity());
+
+        for ( MFIter mfi(old_phi, old_phi, 1, IntVect(AMREX_D_DECL(8,8,8))); mfi.isValid(); ++mfi )
+        {
+            flux_on(mfi, mfi.tilebox());
+        }
+    }
+    else
+    {
+        // Fill the ghost cells of each grid from the other grids
+        // includes periodic domain boundaries
+        old_phi.FillBoundary(geom.periodicity());
+
+        // Fill non-periodic physical boundaries
+        fill_physbc(old_phi, geom);
+
+        // Compute fluxes one grid at a time
+        for ( MFIter mfi(old_phi); mfi.isValid(); ++mfi )
+        {
+            flux_on(mfi, mfi.validbox());
+        }
     }
     
     // Advance the solution one grid at a time